@@ -0,0 +1,92 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Components/EnemyPerceptionComponent.h"
+#include "Subsystems/TargetingSubsystem.h"
+#include "Subsystems/LineOfSightSubsystem.h"
+#include "GameFramework/Pawn.h"
+#include "Engine/World.h"
+
+UEnemyPerceptionComponent::UEnemyPerceptionComponent()
+{
+	// Updated by UEnemyPerceptionSubsystem
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+float UEnemyPerceptionComponent::GetAwareness() const
+{
+	if (!Target.IsValid() || MemoryDuration <= 0.0f) return 0.0f;
+
+	const double Age = GetWorld()->GetTimeSeconds() - LastSensedTime;
+	return FMath::Clamp(1.0f - (float)Age / MemoryDuration, 0.0f, 1.0f);
+}
+
+void UEnemyPerceptionComponent::ReportStimulus(AActor* Source, const FVector& Location, EEnemyStimulusType Type)
+{
+	// Only players are worth hunting
+	const APawn* SourcePawn = Cast<APawn>(Source);
+	if (!SourcePawn || !SourcePawn->IsPlayerControlled()) return;
+
+	// A visible target is not dropped for one that was only heard
+	if (bTargetVisible && Target.IsValid() && Target.Get() != Source) return;
+
+	Sense(Source, Location, Type);
+}
+
+void UEnemyPerceptionComponent::UpdatePerception()
+{
+	const AActor* Owner = GetOwner();
+	UWorld* World = GetWorld();
+	if (!Owner || !World) return;
+
+	// 1. Sight: nearest player in range, already resolved for everyone by the targeting pass
+	bTargetVisible = false;
+
+	UTargetingSubsystem* Targeting = World->GetSubsystem<UTargetingSubsystem>();
+	AActor* Candidate = Targeting ? Targeting->GetTargetFor(Owner) : nullptr;
+
+	// Unaware enemies only notice what is in front of them; once aware, they keep track all around
+	const bool bAware = Candidate && Candidate == Target.Get();
+	if (Candidate && (bAware || IsInSightCone(Candidate->GetActorLocation())))
+	{
+		// Last known visibility from the shared, time-sliced LOS service (no inline trace)
+		ULineOfSightSubsystem* LineOfSight = World->GetSubsystem<ULineOfSightSubsystem>();
+		if (LineOfSight && LineOfSight->HasLineOfSight(Owner, Candidate, EyeOffset))
+		{
+			Sense(Candidate, Candidate->GetActorLocation(), EEnemyStimulusType::Sight);
+			bTargetVisible = true;
+		}
+	}
+
+	// 2. Memory aging
+	const AActor* Remembered = Target.Get();
+	if (!Remembered || Remembered->IsHidden() || World->GetTimeSeconds() - LastSensedTime > MemoryDuration)
+	{
+		ForgetTarget();
+	}
+}
+
+void UEnemyPerceptionComponent::ForgetTarget()
+{
+	Target.Reset();
+	LastStimulusType = EEnemyStimulusType::None;
+	bTargetVisible = false;
+}
+
+bool UEnemyPerceptionComponent::IsInSightCone(const FVector& Location) const
+{
+	const FVector ToLocation = Location - GetOwner()->GetActorLocation();
+	const float DistSq = ToLocation.SizeSquared();
+	if (DistSq <= FMath::Square(ProximityRange)) return true;
+	if (DistSq > FMath::Square(SightRange)) return false;
+
+	const float CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(SightHalfAngle));
+	return FVector::DotProduct(GetOwner()->GetActorForwardVector(), ToLocation.GetSafeNormal()) >= CosHalfAngle;
+}
+
+void UEnemyPerceptionComponent::Sense(AActor* Source, const FVector& Location, EEnemyStimulusType Type)
+{
+	Target = Source;
+	LastKnownLocation = Location;
+	LastStimulusType = Type;
+	LastSensedTime = GetWorld()->GetTimeSeconds();
+}
@@ -110,6 +110,28 @@ void UStatusComponent::Heal(float HealAmount)
 	}
 }
 
+void UStatusComponent::ResetHealth()
+{
+	CurrentHealth = MaxHealth;
+	ScratchHealth = MaxHealth;
+
+	if (OnHealthChanged.IsBound())
+	{
+		OnHealthChanged.Broadcast(CurrentHealth, ScratchHealth, MaxHealth);
+	}
+}
+
+void UStatusComponent::SetCurrentHealth(float NewHealth)
+{
+	CurrentHealth = FMath::Clamp(NewHealth, 0.0f, MaxHealth);
+	ScratchHealth = CurrentHealth;
+
+	if (OnHealthChanged.IsBound())
+	{
+		OnHealthChanged.Broadcast(CurrentHealth, ScratchHealth, MaxHealth);
+	}
+}
+
 float UStatusComponent::GetDamageMultiplier() const
 {
 	// Level 1 = 1.0, Level 2 = 1.1 ...
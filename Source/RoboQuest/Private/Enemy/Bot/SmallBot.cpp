@@ -2,11 +2,13 @@
 
 #include "Enemy/Bot/SmallBot.h"
 #include "RoboQuest/RoboQuestProjectile.h"
+#include "Subsystems/ProjectilePoolSubsystem.h"
+#include "Subsystems/BallisticSimulationSubsystem.h"
 #include "Components/StatusComponent.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Engine/World.h"
-#include "TimerManager.h"
+#include "Subsystems/EnemyAttackSchedulerSubsystem.h"
 #include "Animation/AnimInstance.h"
 
 ASmallBot::ASmallBot()
@@ -34,17 +36,11 @@ void ASmallBot::BeginPlay()
 		StatusComponent->InitializeEnemyStats(TEXT("SmallBot"), 1);
 	}
 
-	// Start firing loop (with random initial delay to desync multiple bots)
-	GetWorld()->GetTimerManager().SetTimer(FireLoopTimerHandle, this, &ASmallBot::TryFire, FireRate, true, FMath::RandRange(0.5f, 1.5f));
-}
-
-void ASmallBot::EndPlay(const EEndPlayReason::Type EndPlayReason)
-{
-	Super::EndPlay(EndPlayReason);
-	
-	// Clear timers to prevent crashes
-	GetWorld()->GetTimerManager().ClearTimer(FireLoopTimerHandle);
-	GetWorld()->GetTimerManager().ClearTimer(AttackSequenceTimerHandle);
+	// Make sure our projectiles are pooled before the first shot
+	if (UProjectilePoolSubsystem* Pool = GetWorld()->GetSubsystem<UProjectilePoolSubsystem>())
+	{
+		Pool->PrewarmPool(ProjectileClass, Pool->DefaultPrewarmCount);
+	}
 }
 
 float ASmallBot::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
@@ -60,12 +56,19 @@ float ASmallBot::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent,
 	return ActualDamage;
 }
 
-void ASmallBot::TryFire()
+void ASmallBot::ResetForReuse(const FVector& Location, const FRotator& Rotation)
+{
+	Super::ResetForReuse(Location, Rotation);
+
+	bIsAttacking = false;
+}
+
+float ASmallBot::TryBeginAttack()
 {
 	// Conditions: Alive, Valid Target, Line of Sight, Not already busy
 	if (!IsAlive() || !CanSeeTarget() || bIsAttacking)
 	{
-		return;
+		return -1.0f;
 	}
 
 	// Double check alignment: Don't shoot if we are facing completely away
@@ -74,7 +77,7 @@ void ASmallBot::TryFire()
 		FVector ToTarget = (CurrentTarget->GetActorLocation() - GetActorLocation()).GetSafeNormal();
 		if (FVector::DotProduct(GetActorForwardVector(), ToTarget) < 0.7f) // +/- 45 degrees
 		{
-			return; // Still turning
+			return -1.0f; // Still turning
 		}
 	}
 
@@ -87,15 +90,8 @@ void ASmallBot::TryFire()
 		PreShootDuration = GetMesh()->GetAnimInstance()->Montage_Play(PreShootMontage);
 	}
 
-	// 2. Schedule PerformShoot
-	if (PreShootDuration > 0.0f)
-	{
-		GetWorld()->GetTimerManager().SetTimer(AttackSequenceTimerHandle, this, &ASmallBot::PerformShoot, PreShootDuration, false);
-	}
-	else
-	{
-		PerformShoot();
-	}
+	// The scheduler calls PerformShoot once the PreShoot is over (right away if there is none)
+	return PreShootDuration;
 }
 
 void ASmallBot::PerformShoot()
@@ -147,22 +143,21 @@ void ASmallBot::FireProjectile()
 		SpawnRot = GetActorRotation();
 	}
 
-	FActorSpawnParameters SpawnParams;
-	SpawnParams.Owner = this;
-	SpawnParams.Instigator = GetInstigator();
-	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-
-	ARoboQuestProjectile* Projectile = GetWorld()->SpawnActor<ARoboQuestProjectile>(ProjectileClass, SpawnLoc, SpawnRot, SpawnParams);
-	if (Projectile)
+	// Simulated centrally or taken from the projectile pool, depending on the projectile class
+	if (UBallisticSimulationSubsystem* Ballistics = GetWorld()->GetSubsystem<UBallisticSimulationSubsystem>())
 	{
-		Projectile->InitializeProjectile(AttackDamage, DetectRange, 1.0f);
+		// Shots carry as far as the enemy can see (DetectRange is in cm, the range in meters)
+		Ballistics->FireProjectile(ProjectileClass, SpawnLoc, SpawnRot, this, GetInstigator(), AttackDamage, DetectRange / 100.0f, 1.0f);
 	}
 }
 
 void ASmallBot::PlayHit()
 {
 	// Interrupt attack sequence on heavy hit
-	GetWorld()->GetTimerManager().ClearTimer(AttackSequenceTimerHandle);
+	if (UEnemyAttackSchedulerSubsystem* Attacks = GetWorld()->GetSubsystem<UEnemyAttackSchedulerSubsystem>())
+	{
+		Attacks->CancelTelegraph(this);
+	}
 	bIsAttacking = false;
 
 	if (HitMontage && GetMesh() && GetMesh()->GetAnimInstance())
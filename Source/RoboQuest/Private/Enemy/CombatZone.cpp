@@ -3,6 +3,10 @@
 #include "Enemy/CombatZone.h"
 #include "Components/BoxComponent.h"
 #include "RoboQuest/RoboQuestCharacter.h"
+#include "Subsystems/EnemySignificanceSubsystem.h"
+#include "Subsystems/EnemySpawnSchedulerSubsystem.h"
+#include "Engine/AssetManager.h"
+#include "HAL/PlatformTime.h"
 
 // Sets default values
 ACombatZone::ACombatZone()
@@ -18,6 +22,12 @@ ACombatZone::ACombatZone()
 	// Default size, meant to be scaled in the level
 	TriggerBox->SetBoxExtent(FVector(500.f, 500.f, 200.f));
 	TriggerBox->SetCollisionProfileName(TEXT("Trigger"));
+
+	// Scaled with the zone; the extra margin gives the streaming time to finish before the player reaches the trigger
+	PrefetchBox = CreateDefaultSubobject<UBoxComponent>(TEXT("PrefetchBox"));
+	PrefetchBox->SetupAttachment(TriggerBox);
+	PrefetchBox->SetBoxExtent(FVector(2500.f, 2500.f, 1000.f));
+	PrefetchBox->SetCollisionProfileName(TEXT("Trigger"));
 }
 
 // Called when the game starts or when spawned
@@ -29,12 +39,97 @@ void ACombatZone::BeginPlay()
 	{
 		TriggerBox->OnComponentBeginOverlap.AddDynamic(this, &ACombatZone::OnOverlapBegin);
 	}
+
+	if (PrefetchBox)
+	{
+		PrefetchBox->OnComponentBeginOverlap.AddDynamic(this, &ACombatZone::OnPrefetchOverlapBegin);
+	}
+}
+
+void ACombatZone::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (PrefetchHandle.IsValid())
+	{
+		PrefetchHandle->CancelHandle();
+		PrefetchHandle.Reset();
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ACombatZone::OnPrefetchOverlapBegin(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+	if (OtherActor && OtherActor->IsA(ARoboQuestCharacter::StaticClass()))
+	{
+		StartPrefetch();
+	}
+}
+
+void ACombatZone::StartPrefetch()
+{
+	if (bPrefetchStarted) return;
+	bPrefetchStarted = true;
+
+	// Loading a class also streams its hard references: meshes, anim blueprint, montages, projectile classes
+	TArray<FSoftObjectPath> AssetsToLoad;
+	for (const AEnemySpawnPoint* Point : SpawnPoints)
+	{
+		if (IsValid(Point) && !Point->EnemyClassToSpawn.IsNull())
+		{
+			AssetsToLoad.AddUnique(Point->EnemyClassToSpawn.ToSoftObjectPath());
+		}
+	}
+
+	PrefetchStartTime = FPlatformTime::Seconds();
+
+	if (AssetsToLoad.Num() == 0)
+	{
+		OnPrefetchComplete();
+		return;
+	}
+
+	PrefetchHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(AssetsToLoad,
+		FStreamableDelegate::CreateUObject(this, &ACombatZone::OnPrefetchComplete));
+}
+
+void ACombatZone::OnPrefetchComplete()
+{
+	bPrefetchComplete = true;
+
+	UE_LOG(LogTemp, Log, TEXT("ACombatZone:: %s prefetch complete in %.1f ms"), *GetName(), (FPlatformTime::Seconds() - PrefetchStartTime) * 1000.0);
+
+	// Create the enemies of this zone up front (a few per frame), so activation only has to place them
+	if (UEnemySpawnSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UEnemySpawnSchedulerSubsystem>())
+	{
+		TMap<UClass*, int32> CountPerClass;
+		for (const AEnemySpawnPoint* Point : SpawnPoints)
+		{
+			if (IsValid(Point))
+			{
+				if (UClass* EnemyClass = Point->EnemyClassToSpawn.Get())
+				{
+					CountPerClass.FindOrAdd(EnemyClass)++;
+				}
+			}
+		}
+
+		for (const TPair<UClass*, int32>& Pair : CountPerClass)
+		{
+			Scheduler->QueuePrewarm(Pair.Key, Pair.Value);
+		}
+	}
+
+	if (bActivationPending)
+	{
+		bActivationPending = false;
+		ActivateZone();
+	}
 }
 
 void ACombatZone::OnOverlapBegin(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
 	// Check if triggered by player and not already active
-	if (!bIsActive && OtherActor && OtherActor->IsA(ARoboQuestCharacter::StaticClass()))
+	if (!bIsActive && !bActivationPending && OtherActor && OtherActor->IsA(ARoboQuestCharacter::StaticClass()))
 	{
 		ActivateZone();
 	}
@@ -42,14 +137,31 @@ void ACombatZone::OnOverlapBegin(UPrimitiveComponent* OverlappedComp, AActor* Ot
 
 void ACombatZone::ActivateZone()
 {
+	// Player got here before (or without going through) the prefetch volume: wait for the streaming
+	if (!bPrefetchComplete)
+	{
+		bActivationPending = true;
+		StartPrefetch();
+		return;
+	}
+
 	bIsActive = true;
 
-	// Iterate through all linked spawn points and spawn enemies
+	UEnemySpawnSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UEnemySpawnSchedulerSubsystem>();
+
+	// Iterate through all linked spawn points and queue their enemies, wave by wave
 	for (AEnemySpawnPoint* Point : SpawnPoints)
 	{
 		if (IsValid(Point))
 		{
-			Point->SpawnEnemy();
+			if (Scheduler)
+			{
+				Scheduler->QueueSpawn(Point, this, Point->WaveIndex * WaveInterval);
+			}
+			else if (AEnemyBase* Enemy = Point->SpawnEnemy())
+			{
+				Enemy->OwningZone = this;
+			}
 
 			// Optional: Destroy the spawn point actor to clean up memory,
 			// since it's just a marker.
@@ -57,6 +169,12 @@ void ACombatZone::ActivateZone()
 		}
 	}
 
+	// Wake up the enemies that were waiting in this zone
+	if (UEnemySignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UEnemySignificanceSubsystem>())
+	{
+		Significance->RefreshZone(this);
+	}
+
 	// Additional Logic:
 	// - Lock doors
 	// - Start background music
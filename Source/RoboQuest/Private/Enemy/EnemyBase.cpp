@@ -4,7 +4,22 @@
 #include "Enemy/EnemyBase.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/StatusComponent.h"
+#include "Components/EnemyPerceptionComponent.h"
 #include "RoboQuest/RoboQuestCharacter.h"
+#include "Subsystems/TargetingSubsystem.h"
+#include "Subsystems/EnemyPerceptionSubsystem.h"
+#include "Subsystems/EnemySignificanceSubsystem.h"
+#include "Subsystems/EnemyPoolSubsystem.h"
+#include "Subsystems/EnemyAttackSchedulerSubsystem.h"
+#include "Subsystems/EnemyLocomotionSubsystem.h"
+#include "Subsystems/CorpseManagerSubsystem.h"
+#include "Subsystems/PickupSubsystem.h"
+#include "Pickups/HealingCell.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "AIController.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimMontage.h"
+#include "TimerManager.h"
 
 // Sets default values
 AEnemyBase::AEnemyBase()
@@ -13,6 +28,12 @@ AEnemyBase::AEnemyBase()
 	PrimaryActorTick.bCanEverTick = true;
 
     StatusComponent = CreateDefaultSubobject<UStatusComponent>(TEXT("StatusComponent"));
+    PerceptionComponent = CreateDefaultSubobject<UEnemyPerceptionComponent>(TEXT("PerceptionComponent"));
+
+    // Animation budget: the pose evaluation rate follows the significance tier through URO
+    // (UEnemySignificanceSubsystem); off screen only montages tick, so their notifies still fire
+    GetMesh()->bEnableUpdateRateOptimizations = true;
+    GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered;
 }
 
 void AEnemyBase::BeginPlay()
@@ -24,6 +45,91 @@ void AEnemyBase::BeginPlay()
     {
         StatusComponent->OnHealthChanged.AddDynamic(this, &AEnemyBase::OnHealthChanged);
     }
+
+    // Remember what dying changes, so a pooled enemy can be put back together
+    DefaultMeshRelativeTransform = GetMesh()->GetRelativeTransform();
+    DefaultMeshCollisionProfile = GetMesh()->GetCollisionProfileName();
+    DefaultCapsuleCollision = GetCapsuleComponent()->GetCollisionEnabled();
+}
+
+void AEnemyBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    UnregisterAIServices();
+
+    if (UCorpseManagerSubsystem* Corpses = GetWorld()->GetSubsystem<UCorpseManagerSubsystem>())
+    {
+        Corpses->UnregisterCorpse(this);
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void AEnemyBase::RegisterAIServices(float DetectRange)
+{
+    RegisteredDetectRange = DetectRange;
+
+    if (UTargetingSubsystem* Targeting = GetWorld()->GetSubsystem<UTargetingSubsystem>())
+    {
+        Targeting->RegisterSeeker(this, DetectRange);
+    }
+
+    // Sight candidates come from the targeting pass above, so both share the same range
+    if (UEnemyPerceptionSubsystem* Perception = GetWorld()->GetSubsystem<UEnemyPerceptionSubsystem>())
+    {
+        PerceptionComponent->SightRange = DetectRange;
+        Perception->RegisterListener(PerceptionComponent);
+    }
+
+    if (UEnemySignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UEnemySignificanceSubsystem>())
+    {
+        Significance->RegisterEnemy(this, DetectRange);
+    }
+
+    if (UEnemyAttackSchedulerSubsystem* Attacks = GetWorld()->GetSubsystem<UEnemyAttackSchedulerSubsystem>())
+    {
+        Attacks->RegisterAttacker(this, GetAttackInterval());
+    }
+
+    if (UEnemyLocomotionSubsystem* Locomotion = GetWorld()->GetSubsystem<UEnemyLocomotionSubsystem>())
+    {
+        Locomotion->RegisterMover(this);
+    }
+}
+
+void AEnemyBase::UnregisterAIServices()
+{
+    if (UTargetingSubsystem* Targeting = GetWorld()->GetSubsystem<UTargetingSubsystem>())
+    {
+        Targeting->UnregisterSeeker(this);
+    }
+
+    if (UEnemyPerceptionSubsystem* Perception = GetWorld()->GetSubsystem<UEnemyPerceptionSubsystem>())
+    {
+        Perception->UnregisterListener(PerceptionComponent);
+    }
+    PerceptionComponent->ForgetTarget();
+
+    // Also restores full tick rates, so the ragdoll and death animation are never throttled
+    if (UEnemySignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UEnemySignificanceSubsystem>())
+    {
+        Significance->UnregisterEnemy(this);
+    }
+
+    if (UEnemyAttackSchedulerSubsystem* Attacks = GetWorld()->GetSubsystem<UEnemyAttackSchedulerSubsystem>())
+    {
+        Attacks->UnregisterAttacker(this);
+    }
+
+    if (UEnemyLocomotionSubsystem* Locomotion = GetWorld()->GetSubsystem<UEnemyLocomotionSubsystem>())
+    {
+        Locomotion->UnregisterMover(this);
+    }
+}
+
+FVector AEnemyBase::GetPerceivedTargetLocation() const
+{
+    const AActor* Target = PerceptionComponent->GetTarget();
+    return (Target && PerceptionComponent->CanSeeTarget()) ? Target->GetActorLocation() : PerceptionComponent->GetLastKnownLocation();
 }
 
 float AEnemyBase::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
@@ -33,9 +139,18 @@ float AEnemyBase::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent
 	// apply damage to status component
     if (StatusComponent && IsAlive())
     {
+        // Damage stimulus: whoever shot us is revealed, wherever they are
+        AActor* DamageSource = EventInstigator ? EventInstigator->GetPawn() : nullptr;
+        if (!DamageSource && DamageCauser)
+        {
+            DamageSource = DamageCauser->GetInstigator();
+        }
+        if (DamageSource)
+        {
+            PerceptionComponent->ReportStimulus(DamageSource, DamageSource->GetActorLocation(), EEnemyStimulusType::Damage);
+        }
+
         StatusComponent->TakeDamage(ActualDamage);
-        
-		// If there is an aggro system, set the DamageCauser as the target here
 
         // can add additional reactions to health changes here (e.g., play hurt animations, sounds, etc.)
     }
@@ -59,6 +174,9 @@ void AEnemyBase::Die()
     
     bIsDead = true;
 
+    // Dead enemies don't need a target or significance anymore
+    UnregisterAIServices();
+
     SpawnDrops();
 
 	// give exp to player
@@ -70,31 +188,265 @@ void AEnemyBase::Die()
 
 	// Disable collisions
     GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-    GetMesh()->SetCollisionProfileName(TEXT("Ragdoll")); // NoCollision
 
-    GetMesh()->SetCollisionResponseToChannel(ECC_Pawn, ECR_Ignore);
-    GetMesh()->SetCollisionResponseToChannel(ECC_GameTraceChannel1, ECR_Ignore);
+    // Ragdoll while the corpse budget allows it, baked death animation otherwise
+    UCorpseManagerSubsystem* Corpses = GetWorld()->GetSubsystem<UCorpseManagerSubsystem>();
+    if (!Corpses || Corpses->RegisterCorpse(this))
+    {
+        StartRagdoll();
+    }
+    else
+    {
+        PlayDeathMontage();
+    }
+
+    if (bIsPooled)
+    {
+        // Keep the controller for the next life, just stop it
+        if (AAIController* AIController = Cast<AAIController>(GetController()))
+        {
+            AIController->StopMovement();
+        }
+    }
+    else
+    {
+        // Detach controller
+        DetachFromControllerPendingDestroy();
+    }
+
+    // Back to the pool (or destroyed) after the ragdoll window, see LifeSpanExpired
+    SetLifeSpan(CorpseLifeSpan);
+}
+
+void AEnemyBase::StartRagdoll()
+{
+    USkeletalMeshComponent* MeshComp = GetMesh();
+    MeshComp->SetCollisionProfileName(TEXT("Ragdoll")); // NoCollision
+
+    MeshComp->SetCollisionResponseToChannel(ECC_Pawn, ECR_Ignore);
+    MeshComp->SetCollisionResponseToChannel(ECC_GameTraceChannel1, ECR_Ignore);
 
 	// enable ragdoll physics
-    GetMesh()->SetSimulatePhysics(true);
+    MeshComp->SetSimulatePhysics(true);
 
-    // Detach controller
-    DetachFromControllerPendingDestroy();
+    // Settled ragdolls sleep instead of simulating for the whole window
+    RagdollStillChecks = 0;
+    GetWorldTimerManager().SetTimer(CorpseTimer, this, &AEnemyBase::CheckRagdollSettled, RagdollSettleCheckInterval, true);
+}
+
+void AEnemyBase::PlayDeathMontage()
+{
+    USkeletalMeshComponent* MeshComp = GetMesh();
+    MeshComp->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 
-    // Destroy actor after a delay (set LifeSpan)
-    SetLifeSpan(5.0f); 
+    UAnimInstance* AnimInstance = MeshComp->GetAnimInstance();
+    const float Duration = (DeathMontage && AnimInstance) ? AnimInstance->Montage_Play(DeathMontage) : 0.0f;
+    if (Duration <= 0.0f)
+    {
+        // Nothing to play: the body still falls, it is only recycled when the corpse budget needs the room
+        StartCheapRagdoll();
+        return;
+    }
+
+    // Hold the final pose: stop updating the mesh before the montage blends out
+    const float FreezeTime = FMath::Max(Duration - DeathMontage->BlendOut.GetBlendTime(), 0.01f);
+    GetWorldTimerManager().SetTimer(CorpseTimer, this, &AEnemyBase::FreezeCorpsePose, FreezeTime, false);
+}
+
+void AEnemyBase::StartCheapRagdoll()
+{
+    USkeletalMeshComponent* MeshComp = GetMesh();
+
+    // No queries and nothing but the level to land on: pawns, shots and traces never touch this body
+    MeshComp->SetCollisionEnabled(ECollisionEnabled::PhysicsOnly);
+    MeshComp->SetCollisionResponseToAllChannels(ECR_Ignore);
+    MeshComp->SetCollisionResponseToChannel(ECC_WorldStatic, ECR_Block);
+    MeshComp->SetSimulatePhysics(true);
+
+    // No settle checks and no ragdoll slot: it simply sleeps after a fixed time
+    GetWorldTimerManager().SetTimer(CorpseTimer, this, &AEnemyBase::FreezeCorpsePose, CheapRagdollSleepTime, false);
+}
+
+void AEnemyBase::FreezeCorpsePose()
+{
+    USkeletalMeshComponent* MeshComp = GetMesh();
+    if (MeshComp->IsSimulatingPhysics())
+    {
+        MeshComp->PutAllRigidBodiesToSleep();
+    }
+    MeshComp->SetComponentTickEnabled(false);
+}
+
+void AEnemyBase::RetireCorpse()
+{
+    if (!bIsDead) return;
+
+    SetLifeSpan(0.0f);
+    LifeSpanExpired();
+}
+
+void AEnemyBase::CheckRagdollSettled()
+{
+    USkeletalMeshComponent* MeshComp = GetMesh();
+    if (!MeshComp->IsSimulatingPhysics())
+    {
+        GetWorldTimerManager().ClearTimer(CorpseTimer);
+        return;
+    }
+
+    // Asleep already, or barely moving
+    const bool bStill = !MeshComp->RigidBodyIsAwake() || MeshComp->GetPhysicsLinearVelocity().SizeSquared() < FMath::Square(RagdollSleepSpeed);
+    RagdollStillChecks = bStill ? RagdollStillChecks + 1 : 0;
+    if (RagdollStillChecks < 2) return;
+
+    GetWorldTimerManager().ClearTimer(CorpseTimer);
+    MeshComp->PutAllRigidBodiesToSleep();
+
+    // Sleeping bodies cost nothing: the slot goes to the next death
+    if (UCorpseManagerSubsystem* Corpses = GetWorld()->GetSubsystem<UCorpseManagerSubsystem>())
+    {
+        Corpses->OnRagdollSettled(this);
+    }
+
+    // The corpse no longer moves: no more pose or physics blend updates until it is recycled
+    MeshComp->SetComponentTickEnabled(false);
+}
+
+void AEnemyBase::LifeSpanExpired()
+{
+    GetWorldTimerManager().ClearTimer(CorpseTimer);
+    if (UCorpseManagerSubsystem* Corpses = GetWorld()->GetSubsystem<UCorpseManagerSubsystem>())
+    {
+        Corpses->UnregisterCorpse(this);
+    }
+
+    if (bIsPooled)
+    {
+        if (UEnemyPoolSubsystem* Pool = GetWorld()->GetSubsystem<UEnemyPoolSubsystem>())
+        {
+            Pool->ReleaseEnemy(this);
+            return;
+        }
+    }
+
+    Super::LifeSpanExpired();
+}
+
+void AEnemyBase::DeactivatePooledEnemy()
+{
+    // Unregister first: leaving the significance manager restores full tick rates
+    UnregisterAIServices();
+
+    bIsDead = true;
+    OwningZone = nullptr;
+    SetLifeSpan(0.0f);
+    GetWorldTimerManager().ClearTimer(CorpseTimer);
+
+    SetActorHiddenInGame(true);
+    SetActorEnableCollision(false);
+    SetActorTickEnabled(false);
+
+    GetMesh()->SetSimulatePhysics(false);
+    GetMesh()->SetComponentTickEnabled(false);
+
+    if (UCharacterMovementComponent* Movement = GetCharacterMovement())
+    {
+        Movement->StopMovementImmediately();
+        Movement->SetComponentTickEnabled(false);
+    }
+
+    if (AController* EnemyController = GetController())
+    {
+        if (AAIController* AIController = Cast<AAIController>(EnemyController))
+        {
+            AIController->StopMovement();
+        }
+        EnemyController->SetActorTickEnabled(false);
+    }
+}
+
+void AEnemyBase::ResetForReuse(const FVector& Location, const FRotator& Rotation)
+{
+    bIsDead = false;
+    SetLifeSpan(0.0f);
+    GetWorldTimerManager().ClearTimer(CorpseTimer);
+
+    if (StatusComponent)
+    {
+        StatusComponent->ResetHealth();
+    }
+
+    // Ragdoll off, mesh back on the capsule with its spawn collision
+    USkeletalMeshComponent* MeshComp = GetMesh();
+    MeshComp->SetSimulatePhysics(false);
+    if (UAnimInstance* AnimInstance = MeshComp->GetAnimInstance())
+    {
+        // Death montage of the previous life
+        AnimInstance->StopAllMontages(0.0f);
+    }
+    MeshComp->AttachToComponent(GetCapsuleComponent(), FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+    MeshComp->SetRelativeTransform(DefaultMeshRelativeTransform);
+    MeshComp->SetCollisionProfileName(DefaultMeshCollisionProfile);
+    MeshComp->SetComponentTickEnabled(true);
+
+    GetCapsuleComponent()->SetCollisionEnabled(DefaultCapsuleCollision);
+    SetActorEnableCollision(true);
+
+    // Same placement rules as AdjustIfPossibleButAlwaysSpawn
+    FVector SpawnLocation = Location;
+    FRotator SpawnRotation = Rotation;
+    GetWorld()->FindTeleportSpot(this, SpawnLocation, SpawnRotation);
+    SetActorLocationAndRotation(SpawnLocation, SpawnRotation, false, nullptr, ETeleportType::ResetPhysics);
+
+    if (UCharacterMovementComponent* Movement = GetCharacterMovement())
+    {
+        Movement->StopMovementImmediately();
+        Movement->SetDefaultMovementMode();
+        Movement->SetComponentTickEnabled(true);
+    }
+
+    SetActorHiddenInGame(false);
+    SetActorTickEnabled(true);
+
+    EnsureController();
+    if (AController* EnemyController = GetController())
+    {
+        EnemyController->SetActorTickEnabled(true);
+        EnemyController->SetControlRotation(SpawnRotation);
+    }
+
+    RegisterAIServices(RegisteredDetectRange);
+}
+
+void AEnemyBase::EnsureController()
+{
+    // Same rule as a fresh spawn: only enemies that auto-possess when spawned get a controller
+    const bool bPossessWhenSpawned = (AutoPossessAI == EAutoPossessAI::Spawned || AutoPossessAI == EAutoPossessAI::PlacedInWorldOrSpawned);
+    if (!GetController() && AIControllerClass && bPossessWhenSpawned)
+    {
+        SpawnDefaultController();
+    }
 }
 
 void AEnemyBase::SpawnDrops()
 {
     if (!HealingCellClass) return;
 
+    UPickupSubsystem* Pickups = GetWorld()->GetSubsystem<UPickupSubsystem>();
+    const AHealingCell* CellDefaults = Cast<AHealingCell>(HealingCellClass->GetDefaultObject());
+
     for (int32 i = 0; i < DropCount; i++)
     {
         // Random Spawn Position around the enemy
         FVector SpawnLoc = GetActorLocation() + FMath::VRand() * 20.0f;
         SpawnLoc.Z += 50.0f; // Drop from body height
 
+        // Stack onto a cell dropped nearby a moment ago (this kill's first one, or a neighbor's) instead of spawning
+        if (Pickups && CellDefaults && Pickups->MergeDrop(SpawnLoc, CellDefaults->GetHealAmount()))
+        {
+            continue;
+        }
+
         FRotator SpawnRot = FMath::VRand().Rotation();
 
         FActorSpawnParameters Params;
@@ -1,8 +1,9 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "Enemy/EnemyBotBase.h"
-#include "Kismet/GameplayStatics.h"
-#include "Kismet/KismetMathLibrary.h"
+#include "Components/EnemyPerceptionComponent.h"
+#include "Subsystems/EnemyLocomotionSubsystem.h"
+#include "Subsystems/FlowFieldSubsystem.h"
 #include "GameFramework/Character.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Components/CapsuleComponent.h"
@@ -16,11 +17,17 @@ AEnemyBotBase::AEnemyBotBase()
 		GetCharacterMovement()->bUseControllerDesiredRotation = false; // We handle rotation manually
 		GetCharacterMovement()->bOrientRotationToMovement = false;
 	}
+
+	// Bots look from their center
+	PerceptionComponent->EyeOffset = FVector::ZeroVector;
 }
 
 void AEnemyBotBase::BeginPlay()
 {
 	Super::BeginPlay();
+
+	// Subscribe to the shared AI services (target acquisition, significance) instead of polling every tick
+	RegisterAIServices(DetectRange);
 }
 
 void AEnemyBotBase::Tick(float DeltaTime)
@@ -33,95 +40,58 @@ void AEnemyBotBase::Tick(float DeltaTime)
 
 	if (HasValidTarget())
 	{
-		// 1. Always rotate to face target (Bot behavior: Hull rotates to target)
-		// NOTE: If you separate Hull and Turret later, this would rotate the whole actor (Hull).
-		RotateTowardsTarget(DeltaTime);
-
-		// 2. Move based on range (No Strafing)
-		MoveTowardsTarget(DeltaTime);
+		// Turn and move are computed in the batched locomotion pass
+		if (UEnemyLocomotionSubsystem* Locomotion = GetWorld()->GetSubsystem<UEnemyLocomotionSubsystem>())
+		{
+			FEnemyLocomotionRequest Request;
+			Request.Enemy = this;
+			Request.Archetype = EEnemyLocomotionArchetype::Bot;
+			Request.DeltaTime = DeltaTime;
+			// Out of sight: where the target was last sensed, not where it really is
+			Request.TargetLocation = GetPerceivedTargetLocation();
+			Request.RotationSpeed = RotationSpeed;
+
+			// 1. Always rotate to face target (Bot behavior: Hull rotates to target)
+			// NOTE: If you separate Hull and Turret later, this would rotate the whole actor (Hull).
+			Request.bRotate = true;
+
+			// 2. Move based on range (No Strafing): chase beyond AttackRange, back up within StopDistance
+			Request.bMove = true;
+			Request.MinRange = StopDistance;
+			Request.MaxRange = AttackRange;
+
+			// Out of sight: turn and drive along the flow field toward the last known location
+			if (!CanSeeTarget())
+			{
+				if (UFlowFieldSubsystem* FlowField = GetWorld()->GetSubsystem<UFlowFieldSubsystem>())
+				{
+					FlowField->GetFlowDirectionToLocation(Request.TargetLocation, GetActorLocation(), Request.SteerDirection);
+				}
+			}
+
+			Locomotion->SubmitRequest(Request);
+		}
 	}
 }
 
 void AEnemyBotBase::FindTarget()
 {
-	// Simple Logic: Get Player 0
-	ACharacter* Player = UGameplayStatics::GetPlayerCharacter(this, 0);
-	if (Player)
-	{
-		float Dist = FVector::Dist(GetActorLocation(), Player->GetActorLocation());
-		if (Dist <= DetectRange)
-		{
-			CurrentTarget = Player;
-		}
-		else
-		{
-			// Lost target if too far (Optional persistence logic can go here)
-			CurrentTarget = nullptr;
-		}
-	}
+	// Remembered target (seen, heard or hit by), kept up to date by UEnemyPerceptionSubsystem
+	CurrentTarget = PerceptionComponent->GetTarget();
 }
 
 bool AEnemyBotBase::HasValidTarget() const
 {
-	return CurrentTarget && !CurrentTarget->IsHidden() && CurrentTarget->GetDistanceTo(this) <= DetectRange;
+	// No range check: the perception memory keeps a target that walked out of DetectRange for a while
+	return CurrentTarget && !CurrentTarget->IsHidden();
 }
 
 bool AEnemyBotBase::CanSeeTarget() const
 {
 	if (!CurrentTarget) return false;
 
-	FHitResult Hit;
-	FVector Start = GetActorLocation();
-	FVector End = CurrentTarget->GetActorLocation();
-	FCollisionQueryParams Params;
-	Params.AddIgnoredActor(this);
-
-	// Simple visibility trace
-	GetWorld()->LineTraceSingleByChannel(Hit, Start, End, ECC_Visibility, Params);
+	// Result of the last sight test of the perception component (cached LOS, no inline trace)
+	const bool bVisible = PerceptionComponent->CanSeeTarget();
 
-	return !Hit.IsValidBlockingHit() || Hit.GetActor() == CurrentTarget;
+	return bVisible;
 }
-
-void AEnemyBotBase::RotateTowardsTarget(float DeltaTime)
-{
-	if (!CurrentTarget) return;
-
-	FVector Direction = CurrentTarget->GetActorLocation() - GetActorLocation();
-	Direction.Z = 0.0f; // Keep it planar
-
-	if (Direction.IsNearlyZero()) return;
-
-	FRotator TargetRot = Direction.Rotation();
-	FRotator CurrentRot = GetActorRotation();
-
-	// Smoothly interpolate rotation (simulates tank turn speed)
-	FRotator NewRot = FMath::RInterpTo(CurrentRot, TargetRot, DeltaTime, RotationSpeed);
-	
-	SetActorRotation(NewRot);
-}
-
-void AEnemyBotBase::MoveTowardsTarget(float DeltaTime)
-{
-	if (!CurrentTarget) return;
-
-	float Dist = FVector::Dist(GetActorLocation(), CurrentTarget->GetActorLocation());
-
-	// Simple State Machine for distance
-	if (Dist > AttackRange)
-	{
-		// Forward: Chase
-		// Only move if we are roughly facing the target (Tank logic)
-		float AngleDot = FVector::DotProduct(GetActorForwardVector(), (CurrentTarget->GetActorLocation() - GetActorLocation()).GetSafeNormal());
-		
-		if (AngleDot > 0.7f) // +/- 45 degrees cone
-		{
-			AddMovementInput(GetActorForwardVector(), 1.0f);
-		}
-	}
-	else if (Dist < StopDistance)
-	{
-		// Backward: Too close (Back up linearly)
-		AddMovementInput(GetActorForwardVector(), -1.0f);
-	}
-	// Else: Hold position (Inside optimal range)
-}
\ No newline at end of file
@@ -4,9 +4,13 @@
 #include "Enemy/EnemyFlyBase.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Components/CapsuleComponent.h"
-#include "Kismet/GameplayStatics.h"
-#include "Kismet/KismetMathLibrary.h"
-#include "DrawDebugHelpers.h"
+#include "Components/EnemyPerceptionComponent.h"
+#include "Subsystems/EnemyDebugDrawSubsystem.h"
+#include "Subsystems/EnemyLocomotionSubsystem.h"
+#include "Subsystems/FlockingSubsystem.h"
+#include "Subsystems/OccupancyGridSubsystem.h"
+#include "Subsystems/FlightNavigationSubsystem.h"
+#include "World/OccupancyGridVolume.h"
 #include "Engine/World.h"
 
 AEnemyFlyBase::AEnemyFlyBase()
@@ -36,6 +40,18 @@ void AEnemyFlyBase::BeginPlay()
 {
 	Super::BeginPlay();
 
+	// Subscribe to the shared AI services (target acquisition, significance) instead of polling every tick
+	RegisterAIServices(DetectRange);
+
+	// Fly-vs-fly spacing comes from the shared spatial hash, not from traces
+	if (bEnableFlocking)
+	{
+		if (UFlockingSubsystem* Flocking = GetWorld()->GetSubsystem<UFlockingSubsystem>())
+		{
+			Flocking->RegisterAgent(this);
+		}
+	}
+
 	if (GetCharacterMovement())
 	{
 		GetCharacterMovement()->SetMovementMode(MOVE_Flying);
@@ -53,6 +69,21 @@ void AEnemyFlyBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 	GetWorld()->GetTimerManager().ClearTimer(HoverTimerHandle);
+
+	if (UFlockingSubsystem* Flocking = GetWorld()->GetSubsystem<UFlockingSubsystem>())
+	{
+		Flocking->UnregisterAgent(this);
+	}
+}
+
+void AEnemyFlyBase::ResetForReuse(const FVector& Location, const FRotator& Rotation)
+{
+	Super::ResetForReuse(Location, Rotation);
+
+	FlightPath.Reset();
+	FlightPathIndex = 0;
+	bPathRequestPending = false;
+	PathRequestSerial++;
 }
 
 void AEnemyFlyBase::Tick(float DeltaTime)
@@ -65,63 +96,79 @@ void AEnemyFlyBase::Tick(float DeltaTime)
 
 	if (HasValidTarget())
 	{
+		FEnemyLocomotionRequest Request;
+		Request.Enemy = this;
+		Request.Archetype = EEnemyLocomotionArchetype::Fly;
+		Request.DeltaTime = DeltaTime;
+		// Out of sight: where the target was last sensed, not where it really is
+		Request.TargetLocation = GetPerceivedTargetLocation();
+		Request.RotationSpeed = RotationSpeed;
+
 		// 1. Look at Target
-		if (CanSeeTarget())
-		{
-			RotateTowardsTarget(DeltaTime);
-		}
+		Request.bRotate = CanSeeTarget();
 
 		// 2. Move (Hovering + Avoidance)
 		if (bEnableHovering)
 		{
 			// Get Avoidance Vector (Push away from walls/ground)
 			FVector Avoidance = CalculateObstacleAvoidance();
-			
-			// Combine Intent (Hover) + Safety (Avoidance)
-			// Avoidance has higher priority, so we simply add it.
-			FVector FinalDirection = (CurrentHoverDirection + Avoidance).GetSafeNormal();
 
-			AddMovementInput(FinalDirection, HoverMoveScale);
+			// Spacing from the other flies (computed once per frame for the whole flock)
+			FVector FlockingSteer = FVector::ZeroVector;
+			if (bEnableFlocking)
+			{
+				if (UFlockingSubsystem* Flocking = GetWorld()->GetSubsystem<UFlockingSubsystem>())
+				{
+					FlockingSteer = Flocking->GetSteering(this) * FlockingWeight;
+				}
+			}
+			
+			// Intent: hover around the target, or fly around the geometry while it is out of sight
+			FVector Intent = CurrentHoverDirection;
+			FVector PathDirection;
+			const bool bFollowingPath = bUseFlightPaths && UpdateFlightPath(Request.bRotate, PathDirection);
+			if (bFollowingPath)
+			{
+				Intent = PathDirection;
+			}
+			
+			// Combine Intent (Hover/Path + Flocking) + Safety (Avoidance)
+			// Avoidance has higher priority, so we simply add it. The pass normalizes the sum.
+			Request.bMove = true;
+			Request.SteerDirection = Intent + FlockingSteer + Avoidance;
+			Request.MoveScale = bFollowingPath ? 1.0f : HoverMoveScale;
+
+#if ENABLE_DRAW_DEBUG
+			// Hover intent (cyan) and final steering direction (blue) (rq.Debug.Hover)
+			if (UEnemyDebugDrawSubsystem::IsCategoryEnabled(EEnemyDebugCategory::Hover))
+			{
+				const FVector FinalDirection = Request.SteerDirection.GetSafeNormal();
+				UEnemyDebugDrawSubsystem::DrawLine(this, EEnemyDebugCategory::Hover, GetActorLocation(), GetActorLocation() + CurrentHoverDirection * 100.0f, FColor::Cyan);
+				UEnemyDebugDrawSubsystem::DrawLine(this, EEnemyDebugCategory::Hover, GetActorLocation(), GetActorLocation() + FinalDirection * 150.0f, FColor::Blue, 2.0f);
+
+				// Remaining flight path (green)
+				FVector PathStart = GetActorLocation();
+				for (int32 i = FlightPathIndex; i < FlightPath.Num(); i++)
+				{
+					UEnemyDebugDrawSubsystem::DrawLine(this, EEnemyDebugCategory::Hover, PathStart, FlightPath[i], FColor::Green);
+					PathStart = FlightPath[i];
+				}
+			}
+#endif
 		}
-	}
-}
 
-void AEnemyFlyBase::FindTarget()
-{
-	// Simple targeting: Get Player 0
-	ACharacter* Player = UGameplayStatics::GetPlayerCharacter(this, 0);
-	if (Player)
-	{
-		float Dist = FVector::Dist(GetActorLocation(), Player->GetActorLocation());
-		if (Dist <= DetectRange)
-		{
-			CurrentTarget = Player;
-		}
-		else
+		// Look-at and steering are computed in the batched locomotion pass
+		if (UEnemyLocomotionSubsystem* Locomotion = GetWorld()->GetSubsystem<UEnemyLocomotionSubsystem>())
 		{
-			CurrentTarget = nullptr;
+			Locomotion->SubmitRequest(Request);
 		}
 	}
 }
 
-void AEnemyFlyBase::RotateTowardsTarget(float DeltaTime)
+void AEnemyFlyBase::FindTarget()
 {
-	if (!CurrentTarget) return;
-
-	// Calculate the rotation needed to look at the target
-	FRotator LookAtRot = UKismetMathLibrary::FindLookAtRotation(GetActorLocation(), CurrentTarget->GetActorLocation());
-
-	// If using Controller Desired Rotation, we might want to update ControlRotation instead
-	// But for direct override referencing PodBase, direct ActorRotation works visually.
-	// For smoother movement integration, consider creating an AIController that calls SetFocus(CurrentTarget).
-	
-	FRotator NewRot = FMath::RInterpTo(GetActorRotation(), LookAtRot, DeltaTime, RotationSpeed);
-	
-	// Lock Pitch/Roll if you want the enemy to stay upright (optional for drones)
-	// NewRot.Pitch = 0.0f;
-	// NewRot.Roll = 0.0f;
-
-	SetActorRotation(NewRot);
+	// Remembered target (seen, heard or hit by), kept up to date by UEnemyPerceptionSubsystem
+	CurrentTarget = PerceptionComponent->GetTarget();
 }
 
 bool AEnemyFlyBase::HasValidTarget() const
@@ -133,23 +180,15 @@ bool AEnemyFlyBase::CanSeeTarget() const
 {
 	if (!CurrentTarget) return false;
 
-	FHitResult Hit;
+	// Result of the last sight test of the perception component (cached LOS, no inline trace)
+	const bool bVisible = PerceptionComponent->CanSeeTarget();
 
-	// Start position: Slightly above actor location to avoid self-collision at feet
-	FVector Start = GetActorLocation() + FVector(0, 0, 50.0f);
-	FVector End = CurrentTarget->GetActorLocation();
+#if ENABLE_DRAW_DEBUG
+	// Debug line (rq.Debug.LOS)
+	UEnemyDebugDrawSubsystem::DrawLine(this, EEnemyDebugCategory::LOS, GetActorLocation() + FVector(0, 0, 50.0f), CurrentTarget->GetActorLocation(), bVisible ? FColor::Green : FColor::Red);
+#endif
 
-	FCollisionQueryParams Params;
-	Params.AddIgnoredActor(this);          // Ignore self
-	Params.AddIgnoredActor(CurrentTarget); // Ignore the target itself
-
-	// Check using Visibility channel
-	bool bHit = GetWorld()->LineTraceSingleByChannel(Hit, Start, End, ECC_Visibility, Params);
-
-	// Debug line (Visible in Editor)
-	DrawDebugLine(GetWorld(), Start, End, bHit ? FColor::Red : FColor::Green, false);
-
-	return !bHit; // Returns true if no obstacles were hit
+	return bVisible;
 }
 
 FVector AEnemyFlyBase::CalculateObstacleAvoidance()
@@ -161,6 +200,15 @@ FVector AEnemyFlyBase::CalculateObstacleAvoidance()
     // Use ForwardVector if velocity is too small (e.g. starting move)
     FVector MoveDir = Velocity.IsNearlyZero() ? GetActorForwardVector() : Velocity.GetSafeNormal();
 
+	// Static geometry is baked in the level's distance field: a few memory reads instead of two traces.
+	// Movable obstacles (doors, platforms) are not in it, so near them we still trace.
+	const UOccupancyGridSubsystem* Grids = GetWorld()->GetSubsystem<UOccupancyGridSubsystem>();
+	const AOccupancyGridVolume* Grid = Grids ? Grids->FindVolume(ActorLocation) : nullptr;
+	if (Grid && !Grid->IsNearDynamicObstacle(ActorLocation, FMath::Max(MinFlightHeight * 1.5f, ObstacleCheckRange) + 50.0f))
+	{
+		return CalculateFieldAvoidance(*Grid, MoveDir);
+	}
+
 	// 1. Ground Avoidance (Maintain Height)
 	FHitResult GroundHit;
 	FCollisionQueryParams Params;
@@ -170,6 +218,12 @@ FVector AEnemyFlyBase::CalculateObstacleAvoidance()
 	FVector DownEnd = ActorLocation - FVector(0, 0, MinFlightHeight * 1.5f);
 	bool bHitGround = GetWorld()->LineTraceSingleByChannel(GroundHit, ActorLocation, DownEnd, ECC_WorldStatic, Params);
 
+#if ENABLE_DRAW_DEBUG
+	// Ground probe (rq.Debug.Avoidance): red up to the ground when it pushes us, grey otherwise
+	UEnemyDebugDrawSubsystem::DrawLine(this, EEnemyDebugCategory::Avoidance, ActorLocation, bHitGround ? GroundHit.ImpactPoint : DownEnd,
+		(bHitGround && GroundHit.Distance < MinFlightHeight) ? FColor::Red : FColor::Silver);
+#endif
+
 	if (bHitGround)
 	{
 		// Force proportional to how close we are to the ground
@@ -204,11 +258,126 @@ FVector AEnemyFlyBase::CalculateObstacleAvoidance()
 		// Add force away from the wall (ImpactNormal)
         // ImpactNormal is the vector pointing out from the wall surface
 		AvoidanceVector += WallHit.ImpactNormal * AvoidanceForceMultiplier;
-        
-        // Debug
-        // DrawDebugLine(GetWorld(), ActorLocation, WallHit.ImpactPoint, FColor::Red, false, 0.1f);
 	}
 
+#if ENABLE_DRAW_DEBUG
+	// Wall probe and resulting push (rq.Debug.Avoidance)
+	if (UEnemyDebugDrawSubsystem::IsCategoryEnabled(EEnemyDebugCategory::Avoidance))
+	{
+		UEnemyDebugDrawSubsystem::DrawLine(this, EEnemyDebugCategory::Avoidance, ForwardStart, bHitWall ? WallHit.ImpactPoint : ForwardEnd, bHitWall ? FColor::Red : FColor::Silver);
+		if (bHitWall)
+		{
+			UEnemyDebugDrawSubsystem::DrawLine(this, EEnemyDebugCategory::Avoidance, WallHit.ImpactPoint, WallHit.ImpactPoint + WallHit.ImpactNormal * SphereRadius * 2.0f, FColor::Orange);
+		}
+		if (!AvoidanceVector.IsNearlyZero())
+		{
+			UEnemyDebugDrawSubsystem::DrawLine(this, EEnemyDebugCategory::Avoidance, ActorLocation, ActorLocation + AvoidanceVector.GetClampedToMaxSize(1.0f) * 100.0f, FColor::Yellow, 2.0f);
+		}
+	}
+#endif
+
+	return AvoidanceVector;
+}
+
+bool AEnemyFlyBase::UpdateFlightPath(bool bCanSeeTarget, FVector& OutDirection)
+{
+	// In sight: back to hovering
+	if (bCanSeeTarget)
+	{
+		FlightPath.Reset();
+		return false;
+	}
+
+	const FVector ActorLocation = GetActorLocation();
+	while (FlightPath.IsValidIndex(FlightPathIndex) && FVector::DistSquared(ActorLocation, FlightPath[FlightPathIndex]) < FMath::Square(WaypointAcceptanceRadius))
+	{
+		FlightPathIndex++;
+	}
+
+	// Aim above the last known location of the target (out of sight here), fliers keep off the ground anyway
+	const FVector Goal = GetPerceivedTargetLocation() + FVector(0.0f, 0.0f, MinFlightHeight);
+
+	// (Re)plan when the path is used up or the target moved away from its end
+	const bool bNeedsPath = !FlightPath.IsValidIndex(FlightPathIndex) || FVector::DistSquared(FlightPath.Last(), Goal) > FMath::Square(RepathDistance);
+	if (bNeedsPath && !bPathRequestPending && GetWorld()->GetTimeSeconds() - LastPathRequestTime >= RepathInterval)
+	{
+		RequestFlightPath(Goal);
+	}
+
+	if (!FlightPath.IsValidIndex(FlightPathIndex)) return false;
+
+	OutDirection = (FlightPath[FlightPathIndex] - ActorLocation).GetSafeNormal();
+	return true;
+}
+
+void AEnemyFlyBase::RequestFlightPath(const FVector& Goal)
+{
+	UFlightNavigationSubsystem* Navigation = GetWorld()->GetSubsystem<UFlightNavigationSubsystem>();
+	if (!Navigation) return;
+
+	LastPathRequestTime = GetWorld()->GetTimeSeconds();
+	bPathRequestPending = true;
+
+	const int32 Serial = ++PathRequestSerial;
+	TWeakObjectPtr<AEnemyFlyBase> WeakThis(this);
+	const bool bStarted = Navigation->RequestPath(GetActorLocation(), Goal, GetCapsuleComponent()->GetScaledCapsuleRadius(),
+		[WeakThis, Serial](const TArray<FVector>& Path)
+		{
+			// Destroyed, recycled or re-requested in the meantime
+			AEnemyFlyBase* Fly = WeakThis.Get();
+			if (!Fly || Fly->PathRequestSerial != Serial) return;
+
+			Fly->bPathRequestPending = false;
+			Fly->FlightPath = Path;
+			Fly->FlightPathIndex = 0;
+		});
+
+	// No grid around here: keep hovering
+	if (!bStarted)
+	{
+		bPathRequestPending = false;
+	}
+}
+
+FVector AEnemyFlyBase::CalculateFieldAvoidance(const AOccupancyGridVolume& Grid, const FVector& MoveDir) const
+{
+	FVector AvoidanceVector = FVector::ZeroVector;
+	const FVector ActorLocation = GetActorLocation();
+
+	// Same radius as the wall sweep; anything within half a voxel of it counts as touching
+	const float ProbeRadius = 50.0f + Grid.GetGridVoxelSize() * 0.5f;
+
+	// 1. Keep clear of the nearest geometry (mostly the ground), harder the closer it is
+	FVector Gradient;
+	const float Distance = Grid.SampleDistanceAndGradient(ActorLocation, Gradient);
+	if (Distance < MinFlightHeight)
+	{
+		float PushRatio = 1.0f - (Distance / MinFlightHeight);
+		AvoidanceVector += Gradient * PushRatio * AvoidanceForceMultiplier;
+	}
+
+	// 2. Geometry at the end of the forward probe: push away from it, like the wall hit normal
+	const FVector ProbeEnd = ActorLocation + (MoveDir * ObstacleCheckRange);
+	FVector AheadGradient;
+	const float AheadDistance = Grid.SampleDistanceAndGradient(ProbeEnd, AheadGradient);
+	const bool bBlockedAhead = (AheadDistance < ProbeRadius);
+	if (bBlockedAhead)
+	{
+		AvoidanceVector += AheadGradient * AvoidanceForceMultiplier;
+	}
+
+#if ENABLE_DRAW_DEBUG
+	// Field probe and resulting push (rq.Debug.Avoidance)
+	if (UEnemyDebugDrawSubsystem::IsCategoryEnabled(EEnemyDebugCategory::Avoidance))
+	{
+		UEnemyDebugDrawSubsystem::DrawLine(this, EEnemyDebugCategory::Avoidance, ActorLocation, ProbeEnd, bBlockedAhead ? FColor::Red : FColor::Silver);
+		if (!AvoidanceVector.IsNearlyZero())
+		{
+			UEnemyDebugDrawSubsystem::DrawLine(this, EEnemyDebugCategory::Avoidance, ActorLocation, ActorLocation + AvoidanceVector.GetClampedToMaxSize(1.0f) * 100.0f, FColor::Yellow, 2.0f);
+		}
+	}
+#endif
+
 	return AvoidanceVector;
 }
 
@@ -221,7 +390,7 @@ void AEnemyFlyBase::PickNewHoverDirection()
 
 	if (HasValidTarget())
 	{
-		FVector ToTarget = CurrentTarget->GetActorLocation() - GetActorLocation();
+		FVector ToTarget = GetPerceivedTargetLocation() - GetActorLocation();
 		float Dist = ToTarget.Size();
 		FVector DirToTarget = ToTarget.GetSafeNormal();
 
@@ -2,44 +2,202 @@
 
 #include "Enemy/EnemyPawnAIController.h"
 #include "Enemy/EnemyPawnBase.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "RoboQuest/RoboQuest.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+	// Path requests of every enemy pawn controller, published once per second
+	int32 PathRequestsThisSecond = 0;
+	int32 PathRequestsLastSecond = 0;
+	double PathRequestWindowStart = 0.0;
+
+	void PublishPathRequestRate()
+	{
+		const double Now = FPlatformTime::Seconds();
+		if (Now - PathRequestWindowStart >= 1.0)
+		{
+			PathRequestsLastSecond = PathRequestsThisSecond;
+			PathRequestsThisSecond = 0;
+			PathRequestWindowStart = Now;
+			SET_DWORD_STAT(STAT_EnemyPathRequestsPerSecond, PathRequestsLastSecond);
+		}
+	}
+}
 
 AEnemyPawnAIController::AEnemyPawnAIController()
 {
 	PrimaryActorTick.bCanEverTick = true;
 }
 
+int32 AEnemyPawnAIController::GetPathRequestsPerSecond()
+{
+	return PathRequestsLastSecond;
+}
+
 void AEnemyPawnAIController::OnPossess(APawn* InPawn)
 {
 	Super::OnPossess(InPawn);
+
+	// Cached once instead of cast every tick
+	EnemyPawn = Cast<AEnemyPawnBase>(InPawn);
+	State = EEnemyPawnAIState::Idle;
+	LastTarget.Reset();
+	PerceivedTargetLocation = FVector::ZeroVector;
+	bRepositionDone = false;
+	bHasPath = false;
+}
+
+void AEnemyPawnAIController::OnUnPossess()
+{
+	Super::OnUnPossess();
+
+	EnemyPawn = nullptr;
+	State = EEnemyPawnAIState::Idle;
 }
 
 void AEnemyPawnAIController::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	AEnemyPawnBase* EnemyPawn = Cast<AEnemyPawnBase>(GetPawn());
-	if (EnemyPawn && EnemyPawn->IsAlive())
+	PublishPathRequestRate();
+
+	if (!EnemyPawn || !EnemyPawn->IsAlive())
 	{
-		AActor* Target = EnemyPawn->GetTarget();
-		if (Target)
+		if (State != EEnemyPawnAIState::Idle)
 		{
-			float Dist = FVector::Dist(EnemyPawn->GetActorLocation(), Target->GetActorLocation());
-			
-			// If target is far away or not visible, use NavMesh pathfinding
-			// DetectRange (1500) within which we engage directly
-			// But if walls are in between, we need pathfinding even if close.
-			bool bCanSee = EnemyPawn->CanSeeTarget();
-
-			if (!bCanSee || Dist > EnemyPawn->PreferredMaxRange * 1.5f) 
-			{
-				// Far away or blocked: Use NavMesh to get closer
-				MoveToActor(Target, EnemyPawn->PreferredMaxRange);
-			}
-			else
-			{
-				// Close and visible: Stop NavMesh movement and let Pawn handle CombatMove
-				StopMovement();
-			}
+			EnterState(EEnemyPawnAIState::Idle);
 		}
+		return;
+	}
+
+	// Events: target changed, target sighted / lost, new stimulus (all from the pawn's perception)
+	AActor* Target = EnemyPawn->GetTarget();
+	const bool bCanSee = Target && EnemyPawn->CanSeeTarget();
+
+	// A remembered target always has a location: where it is in sight, where it was last sensed otherwise
+	PerceivedTargetLocation = EnemyPawn->GetPerceivedTargetLocation();
+
+	if (Target != LastTarget.Get())
+	{
+		LastTarget = Target;
+		bRepositionDone = false;
+	}
+
+	// Sighted again, or sensed away from the location we already checked: worth a new look
+	if (bCanSee || (bRepositionDone && FVector::DistSquared(PathGoal, PerceivedTargetLocation) > FMath::Square(RepathDistance)))
+	{
+		bRepositionDone = false;
+	}
+
+	const EEnemyPawnAIState NewState = EvaluateState(Target != nullptr, bCanSee);
+	if (NewState != State)
+	{
+		EnterState(NewState);
+	}
+	else
+	{
+		UpdateMovement();
+	}
+}
+
+EEnemyPawnAIState AEnemyPawnAIController::EvaluateState(bool bHasTarget, bool bCanSee) const
+{
+	if (!bHasTarget) return EEnemyPawnAIState::Idle;
+
+	const float Dist = FVector::Dist(EnemyPawn->GetActorLocation(), PerceivedTargetLocation);
+	if (Dist > EnemyPawn->PreferredMaxRange * 1.5f)
+	{
+		return EEnemyPawnAIState::Approach;
+	}
+
+	if (bCanSee)
+	{
+		return EEnemyPawnAIState::Engage;
 	}
-}
\ No newline at end of file
+
+	// Close but out of sight: check where it was last sensed first
+	return bRepositionDone ? EEnemyPawnAIState::Approach : EEnemyPawnAIState::Reposition;
+}
+
+void AEnemyPawnAIController::EnterState(EEnemyPawnAIState NewState)
+{
+	State = NewState;
+	bHasPath = false;
+
+	switch (State)
+	{
+	case EEnemyPawnAIState::Idle:
+	case EEnemyPawnAIState::Engage:
+		// Close and visible: Stop NavMesh movement and let the Pawn handle its combat movement
+		StopMovement();
+		break;
+
+	case EEnemyPawnAIState::Approach:
+	case EEnemyPawnAIState::Reposition:
+		UpdateMovement();
+		break;
+	}
+}
+
+void AEnemyPawnAIController::UpdateMovement()
+{
+	if (State != EEnemyPawnAIState::Approach && State != EEnemyPawnAIState::Reposition) return;
+
+	// The pawn walks along the shared flow field: no path of our own
+	if (EnemyPawn->IsFollowingFlowField())
+	{
+		if (bHasPath)
+		{
+			StopMovement();
+			bHasPath = false;
+		}
+		return;
+	}
+
+	// New path only when the goal got away from the one of the current path (new sighting, noise or hit)
+	const bool bGoalMoved = FVector::DistSquared(PathGoal, PerceivedTargetLocation) > FMath::Square(RepathDistance);
+
+	if (State == EEnemyPawnAIState::Reposition)
+	{
+		// To the last known location, OnMoveCompleted ends it
+		if (!bHasPath || bGoalMoved)
+		{
+			RequestPathTo(PerceivedTargetLocation, 50.0f);
+		}
+		return;
+	}
+
+	// Approach: also when the previous path ended (unless it ended at the last known location, already checked)
+	if (!bHasPath || bGoalMoved || (GetMoveStatus() == EPathFollowingStatus::Idle && !bRepositionDone))
+	{
+		RequestPathTo(PerceivedTargetLocation, EnemyPawn->PreferredMaxRange);
+	}
+}
+
+void AEnemyPawnAIController::RequestPathTo(const FVector& Goal, float AcceptanceRadius)
+{
+	const float Now = GetWorld()->GetTimeSeconds();
+	if (Now - LastPathRequestTime < MinRepathInterval) return;
+
+	LastPathRequestTime = Now;
+	PathGoal = Goal;
+	bHasPath = true;
+
+	MoveToLocation(Goal, AcceptanceRadius);
+
+	INC_DWORD_STAT(STAT_EnemyPathRequests);
+	PathRequestsThisSecond++;
+}
+
+void AEnemyPawnAIController::OnMoveCompleted(FAIRequestID RequestID, const FPathFollowingResult& Result)
+{
+	Super::OnMoveCompleted(RequestID, Result);
+
+	// Reached (or failed to reach) the last known location without seeing the target: approach it instead
+	if (State == EEnemyPawnAIState::Reposition && Result.Code != EPathFollowingResult::Aborted)
+	{
+		bRepositionDone = true;
+	}
+}
@@ -3,8 +3,10 @@
 #include "Enemy/EnemyPawnBase.h"
 #include "Enemy/EnemyPawnAIController.h"
 #include "GameFramework/CharacterMovementComponent.h"
-#include "Kismet/GameplayStatics.h"
-#include "Kismet/KismetMathLibrary.h"
+#include "Components/EnemyPerceptionComponent.h"
+#include "Subsystems/EnemyDebugDrawSubsystem.h"
+#include "Subsystems/EnemyLocomotionSubsystem.h"
+#include "Subsystems/FlowFieldSubsystem.h"
 #include "TimerManager.h"
 
 AEnemyPawnBase::AEnemyPawnBase()
@@ -36,6 +38,9 @@ void AEnemyPawnBase::BeginPlay()
 {
 	Super::BeginPlay();
 
+	// Subscribe to the shared AI services (target acquisition, significance) instead of polling every tick
+	RegisterAIServices(DetectRange);
+
 	// Start the strafing logic loop
 	if (GetWorld())
 	{
@@ -57,129 +62,57 @@ void AEnemyPawnBase::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	bFollowingFlowField = false;
+
 	if (!IsAlive()) return;
 
 	FindTarget();
 
 	if (HasValidTarget())
 	{
-		// Always face target
-		RotateTowardsTarget(DeltaTime);
-
-		// Movement Logic Logic:
-		// We only Manual Move (CombatMove) if we are close enough and have Line of Sight.
-		// Otherwise, the AIController handles the pathfinding approach.
-
-		float Dist = FVector::Dist(GetActorLocation(), CurrentTarget->GetActorLocation());
-		bool bCanSee = CanSeeTarget(); // Assuming you have this function exposed or check it here
-
-		// This threshold logic matches the AIController's switch logic
-		if (bCanSee && Dist <= PreferredMaxRange * 1.5f)
+		// Facing and combat movement are computed in the batched locomotion pass
+		if (UEnemyLocomotionSubsystem* Locomotion = GetWorld()->GetSubsystem<UEnemyLocomotionSubsystem>())
 		{
-			CombatMove(DeltaTime);
+			FEnemyLocomotionRequest Request;
+			Request.Enemy = this;
+			Request.Archetype = EEnemyLocomotionArchetype::Pawn;
+			Request.DeltaTime = DeltaTime;
+			// Out of sight: where the target was last sensed, not where it really is
+			Request.TargetLocation = GetPerceivedTargetLocation();
+			Request.RotationSpeed = RotationSpeed;
+
+			// Always face target
+			Request.bRotate = true;
+
+			// Far away: approach along the flow field shared by every enemy chasing this target.
+			// Out of sight: along the field toward its last known location.
+			const bool bCanSee = CanSeeTarget();
+			const bool bApproach = !bCanSee || FVector::Dist(GetActorLocation(), Request.TargetLocation) > PreferredMaxRange * 1.5f;
+			UFlowFieldSubsystem* FlowField = GetWorld()->GetSubsystem<UFlowFieldSubsystem>();
+			if (bApproach && FlowField)
+			{
+				bFollowingFlowField = bCanSee
+					? FlowField->GetFlowDirection(CurrentTarget, GetActorLocation(), Request.SteerDirection)
+					: FlowField->GetFlowDirectionToLocation(Request.TargetLocation, GetActorLocation(), Request.SteerDirection);
+			}
+
+			// Otherwise we only Manual Move (CombatMove) if we are close enough (checked by the pass) and have Line of Sight.
+			// Without a flow field, the AIController handles the pathfinding approach.
+			Request.bMove = bCanSee || bFollowingFlowField;
+			Request.MinRange = PreferredMinRange;
+			Request.MaxRange = PreferredMaxRange;
+			Request.MoveScale = StrafeSpeed;
+			Request.StrafeScale = StrafeDirectionScale;
+
+			Locomotion->SubmitRequest(Request);
 		}
 	}
 }
 
 void AEnemyPawnBase::FindTarget()
 {
-	// Simple targeting: Get Player 0
-	ACharacter* Player = UGameplayStatics::GetPlayerCharacter(this, 0);
-	if (Player)
-	{
-		float Dist = FVector::Dist(GetActorLocation(), Player->GetActorLocation());
-		if (Dist <= DetectRange)
-		{
-			CurrentTarget = Player;
-		}
-		else
-		{
-			CurrentTarget = nullptr;
-		}
-	}
-	else
-	{
-		CurrentTarget = nullptr;
-	}
-}
-
-void AEnemyPawnBase::RotateTowardsTarget(float DeltaTime)
-{
-	if (!CurrentTarget) return;
-
-	FVector Start = GetActorLocation();
-	FVector End = CurrentTarget->GetActorLocation();
-
-	// Look at target but lock pitch/roll (grounded)
-	FRotator LookAtRot = UKismetMathLibrary::FindLookAtRotation(Start, End);
-	LookAtRot.Pitch = 0.0f;
-	LookAtRot.Roll = 0.0f;
-
-	FRotator NewRot = FMath::RInterpTo(GetActorRotation(), LookAtRot, DeltaTime, RotationSpeed);
-	SetActorRotation(NewRot);
-}
-
-void AEnemyPawnBase::CombatMove(float DeltaTime)
-{
-	if (!CurrentTarget) return;
-
-	FVector MyLoc = GetActorLocation();
-	FVector TargetLoc = CurrentTarget->GetActorLocation();
-
-	float Dist = FVector::Dist(MyLoc, TargetLoc);
-
-	// Calculate flat direction to target
-	FVector ToTarget = (TargetLoc - MyLoc);
-	ToTarget.Z = 0.0f;
-	if (!ToTarget.IsNearlyZero())
-	{
-		ToTarget.Normalize();
-	}
-	else
-	{
-		ToTarget = GetActorForwardVector();
-		ToTarget.Z = 0.0f;
-		ToTarget.Normalize();
-	}
-
-	FVector MoveDirection = FVector::ZeroVector;
-
-	// Range management: move forward/back to maintain preferred range
-	if (Dist > PreferredMaxRange)
-	{
-		// Too far: move toward target
-		MoveDirection += ToTarget;
-	}
-	else if (Dist < PreferredMinRange)
-	{
-		// Too close: back away from target
-		MoveDirection -= ToTarget;
-	}
-	// If within preferred band, no forward/back movement
-
-	// Strafing: add lateral movement based on current strafe scale
-	if (StrafeDirectionScale != 0.0f)
-	{
-		FVector RightVector = FVector::CrossProduct(ToTarget, FVector::UpVector);
-		RightVector.Z = 0.0f;
-		if (!RightVector.IsNearlyZero())
-		{
-			RightVector.Normalize();
-			MoveDirection += RightVector * StrafeDirectionScale;
-		}
-	}
-
-	// Prevent zero vector add; normalize to avoid faster diagonal movement
-	if (!MoveDirection.IsNearlyZero())
-	{
-		MoveDirection.Normalize();
-		AddMovementInput(MoveDirection, StrafeSpeed);
-	}
-	else
-	{
-		// Optionally, stop movement input to hold position
-		// No explicit stop necessary; CharacterMovement will decelerate
-	}
+	// Remembered target (seen, heard or hit by), kept up to date by UEnemyPerceptionSubsystem
+	CurrentTarget = PerceptionComponent->GetTarget();
 }
 
 void AEnemyPawnBase::MoveToTarget()
@@ -215,17 +148,13 @@ bool AEnemyPawnBase::CanSeeTarget() const
 {
 	if (!CurrentTarget) return false;
 
-	FHitResult Hit;
-	FVector Start = GetActorLocation() + FVector(0, 0, 50.0f);
-	FVector End = CurrentTarget->GetActorLocation();
+	// Result of the last sight test of the perception component (cached LOS, no inline trace)
+	const bool bVisible = PerceptionComponent->CanSeeTarget();
 
-	FCollisionQueryParams Params;
-	Params.AddIgnoredActor(this);
-	Params.AddIgnoredActor(CurrentTarget);
+#if ENABLE_DRAW_DEBUG
+	// Debug line (rq.Debug.LOS)
+	UEnemyDebugDrawSubsystem::DrawLine(this, EEnemyDebugCategory::LOS, GetActorLocation() + FVector(0, 0, 50.0f), CurrentTarget->GetActorLocation(), bVisible ? FColor::Green : FColor::Red);
+#endif
 
-	bool bHit = GetWorld()->LineTraceSingleByChannel(Hit, Start, End, ECC_Visibility, Params);
-
-	DrawDebugLine(GetWorld(), Start, End, bHit ? FColor::Red : FColor::Green, false);
-
-	return !bHit;
-}
\ No newline at end of file
+	return bVisible;
+}
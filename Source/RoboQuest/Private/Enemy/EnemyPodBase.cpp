@@ -2,10 +2,10 @@
 
 #include "Enemy/EnemyPodBase.h"
 #include "GameFramework/CharacterMovementComponent.h"
-#include "Kismet/GameplayStatics.h"
-#include "Kismet/KismetMathLibrary.h"
+#include "Components/EnemyPerceptionComponent.h"
+#include "Subsystems/EnemyDebugDrawSubsystem.h"
+#include "Subsystems/EnemyLocomotionSubsystem.h"
 #include "Engine/World.h"
-#include "DrawDebugHelpers.h"
 
 AEnemyPodBase::AEnemyPodBase()
 {
@@ -14,6 +14,17 @@ AEnemyPodBase::AEnemyPodBase()
 	
 	// Prevent the character from adhering to the controller's rotation yaw (We handle rotation manually)
 	bUseControllerRotationYaw = false;
+
+	// Turret: watches all around
+	PerceptionComponent->SightHalfAngle = 180.0f;
+}
+
+void AEnemyPodBase::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Subscribe to the shared AI services (target acquisition, significance) instead of polling every tick
+	RegisterAIServices(DetectRange);
 }
 
 void AEnemyPodBase::Tick(float DeltaTime)
@@ -28,39 +39,25 @@ void AEnemyPodBase::Tick(float DeltaTime)
 	// Rotate only if we have a valid target and can actually see it (not blocked by walls)
 	if (HasValidTarget() && CanSeeTarget())
 	{
-		RotateTowardsTarget(DeltaTime);
-	}
-}
-
-void AEnemyPodBase::FindTarget()
-{
-	// Simple targeting: Get Player 0
-	// (Can be improved with AI Perception later)
-	ACharacter* Player = UGameplayStatics::GetPlayerCharacter(this, 0);
-	if (Player)
-	{
-		float Dist = FVector::Dist(GetActorLocation(), Player->GetActorLocation());
-		if (Dist <= DetectRange)
+		// Look-at is computed in the batched locomotion pass
+		if (UEnemyLocomotionSubsystem* Locomotion = GetWorld()->GetSubsystem<UEnemyLocomotionSubsystem>())
 		{
-			CurrentTarget = Player;
-		}
-		else
-		{
-			CurrentTarget = nullptr;
+			FEnemyLocomotionRequest Request;
+			Request.Enemy = this;
+			Request.Archetype = EEnemyLocomotionArchetype::Pod;
+			Request.DeltaTime = DeltaTime;
+			Request.TargetLocation = GetPerceivedTargetLocation();
+			Request.RotationSpeed = RotationSpeed;
+			Request.bRotate = true;
+			Locomotion->SubmitRequest(Request);
 		}
 	}
 }
 
-void AEnemyPodBase::RotateTowardsTarget(float DeltaTime)
+void AEnemyPodBase::FindTarget()
 {
-	if (!CurrentTarget) return;
-
-	// Calculate the rotation needed to look at the target
-	FRotator LookAtRot = UKismetMathLibrary::FindLookAtRotation(GetActorLocation(), CurrentTarget->GetActorLocation());
-    
-    // Smoothly interpolate current rotation to target rotation
-	FRotator NewRot = FMath::RInterpTo(GetActorRotation(), LookAtRot, DeltaTime, RotationSpeed);
-	SetActorRotation(NewRot);
+	// Remembered target (seen, heard or hit by), kept up to date by UEnemyPerceptionSubsystem
+	CurrentTarget = PerceptionComponent->GetTarget();
 }
 
 bool AEnemyPodBase::HasValidTarget() const
@@ -72,24 +69,13 @@ bool AEnemyPodBase::CanSeeTarget() const
 {
 	if (!CurrentTarget) return false;
 
-	FHitResult Hit;
-	
-    // Start position: Eye location or Actor location with offset
-    // (Using Mesh socket or EyePosition is better for accuracy, currently using ActorLocation + height offset)
-	FVector Start = GetActorLocation() + FVector(0, 0, 50.0f); 
-	FVector End = CurrentTarget->GetActorLocation();
-
-	FCollisionQueryParams Params;
-	Params.AddIgnoredActor(this);          // Ignore self
-	Params.AddIgnoredActor(CurrentTarget); // Ignore the target itself (to check against obstacles only)
-
-	// Check using Visibility channel (Walls usually block Visibility)
-	bool bHit = GetWorld()->LineTraceSingleByChannel(Hit, Start, End, ECC_Visibility, Params);
+	// Result of the last sight test of the perception component (cached LOS, no inline trace)
+	const bool bVisible = PerceptionComponent->CanSeeTarget();
 
-	// Debug line
-	DrawDebugLine(GetWorld(), Start, End, bHit ? FColor::Red : FColor::Green, false);
+#if ENABLE_DRAW_DEBUG
+	// Debug line (rq.Debug.LOS)
+	UEnemyDebugDrawSubsystem::DrawLine(this, EEnemyDebugCategory::LOS, GetActorLocation() + FVector(0, 0, 50.0f), CurrentTarget->GetActorLocation(), bVisible ? FColor::Green : FColor::Red);
+#endif
 
-	// If bHit is true, it means there is an obstacle (Wall) -> Not visible
-	// If bHit is false, the trace went through -> Visible
-	return !bHit;
+	return bVisible;
 }
@@ -3,6 +3,7 @@
 #include "Enemy/EnemySpawnPoint.h"
 #include "Components/ArrowComponent.h"
 #include "Engine/World.h"
+#include "Subsystems/EnemyPoolSubsystem.h"
 
 // Sets default values
 AEnemySpawnPoint::AEnemySpawnPoint()
@@ -19,16 +20,34 @@ AEnemySpawnPoint::AEnemySpawnPoint()
 
 AEnemyBase* AEnemySpawnPoint::SpawnEnemy()
 {
-    if (!EnemyClassToSpawn)
+    if (EnemyClassToSpawn.IsNull())
     {
         return nullptr;
     }
 
+    // Normally streamed in by the combat zone prefetch; loading here blocks the game thread
+    UClass* EnemyClass = EnemyClassToSpawn.Get();
+    if (!EnemyClass)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("AEnemySpawnPoint:: %s was not prefetched, loading it synchronously"), *EnemyClassToSpawn.ToString());
+        EnemyClass = EnemyClassToSpawn.LoadSynchronous();
+        if (!EnemyClass)
+        {
+            return nullptr;
+        }
+    }
+
+    // Taken from the enemy pool (pre-warmed by the combat zone) and placed at this actor's location and rotation
+    if (UEnemyPoolSubsystem* Pool = GetWorld()->GetSubsystem<UEnemyPoolSubsystem>())
+    {
+        return Pool->AcquireEnemy(EnemyClass, GetActorLocation(), GetActorRotation());
+    }
+
     FActorSpawnParameters SpawnParams;
     SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
     
     // Instant spawn at this actor's location and rotation
-    AEnemyBase* SpawnedEnemy = GetWorld()->SpawnActor<AEnemyBase>(EnemyClassToSpawn, GetActorLocation(), GetActorRotation(), SpawnParams);
+    AEnemyBase* SpawnedEnemy = GetWorld()->SpawnActor<AEnemyBase>(EnemyClass, GetActorLocation(), GetActorRotation(), SpawnParams);
 
     return SpawnedEnemy;
 }
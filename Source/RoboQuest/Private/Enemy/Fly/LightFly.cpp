@@ -2,9 +2,12 @@
 
 #include "Enemy/Fly/LightFly.h"
 #include "../../../RoboQuestProjectile.h"
+#include "Subsystems/ProjectilePoolSubsystem.h"
+#include "Subsystems/BallisticSimulationSubsystem.h"
 #include "Components/StatusComponent.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "TimerManager.h"
+#include "Subsystems/EnemyAttackSchedulerSubsystem.h"
 #include "Engine/World.h"
 #include "Animation/AnimInstance.h"
 
@@ -27,16 +30,17 @@ void ALightFly::BeginPlay()
 		StatusComponent->InitializeEnemyStats(TEXT("LightFly"), 1);
 	}
 
-	// Only manage Combat Loop here
-	GetWorld()->GetTimerManager().SetTimer(FireLoopTimerHandle, this, &ALightFly::TryFire, FireRate, true);
+	// Make sure our projectiles are pooled before the first shot
+	if (UProjectilePoolSubsystem* Pool = GetWorld()->GetSubsystem<UProjectilePoolSubsystem>())
+	{
+		Pool->PrewarmPool(ProjectileClass, Pool->DefaultPrewarmCount);
+	}
 }
 
 void ALightFly::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 	
-	GetWorld()->GetTimerManager().ClearTimer(FireLoopTimerHandle);
-	GetWorld()->GetTimerManager().ClearTimer(AttackSequenceTimerHandle);
 	GetWorld()->GetTimerManager().ClearTimer(HoverTimerHandle);
 }
 
@@ -60,23 +64,33 @@ float ALightFly::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent,
 	return ActualDamage;
 }
 
+void ALightFly::ResetForReuse(const FVector& Location, const FRotator& Rotation)
+{
+	Super::ResetForReuse(Location, Rotation);
+
+	bIsAttacking = false;
+}
+
 void ALightFly::PlayHit()
 {
 	if (HitMontage && GetMesh() && GetMesh()->GetAnimInstance())
 	{
-		GetWorld()->GetTimerManager().ClearTimer(AttackSequenceTimerHandle);
+		if (UEnemyAttackSchedulerSubsystem* Attacks = GetWorld()->GetSubsystem<UEnemyAttackSchedulerSubsystem>())
+		{
+			Attacks->CancelTelegraph(this);
+		}
 		bIsAttacking = false;
 		
 		GetMesh()->GetAnimInstance()->Montage_Play(HitMontage);
 	}
 }
 
-void ALightFly::TryFire()
+float ALightFly::TryBeginAttack()
 {
 	// Use parent helper functions: IsAlive(), HasValidTarget(), CanSeeTarget()
 	if (!IsAlive() || !HasValidTarget() || !CanSeeTarget() || bIsAttacking)
 	{
-		return;
+		return -1.0f;
 	}
 
 	bIsAttacking = true;
@@ -87,14 +101,8 @@ void ALightFly::TryFire()
 		PreShootDuration = GetMesh()->GetAnimInstance()->Montage_Play(PreShootMontage);
 	}
 
-	if (PreShootDuration > 0.0f)
-	{
-		GetWorld()->GetTimerManager().SetTimer(AttackSequenceTimerHandle, this, &ALightFly::PerformShoot, PreShootDuration, false);
-	}
-	else
-	{
-		PerformShoot();
-	}
+	// The scheduler calls PerformShoot once the PreShoot is over (right away if there is none)
+	return PreShootDuration;
 }
 
 void ALightFly::PerformShoot()
@@ -130,17 +138,11 @@ void ALightFly::FireProjectile()
 		SpawnLoc += GetActorForwardVector() * 50.0f;
 	}
 
-	FActorSpawnParameters ActorSpawnParams;
-	ActorSpawnParams.Owner = this;
-	ActorSpawnParams.Instigator = GetInstigator();
-	ActorSpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-
-	// Use DetectRange from parent class
-	ARoboQuestProjectile* Projectile = GetWorld()->SpawnActor<ARoboQuestProjectile>(ProjectileClass, SpawnLoc, SpawnRot, ActorSpawnParams);
-
-	if (Projectile)
+	// Simulated centrally or taken from the projectile pool, depending on the projectile class
+	if (UBallisticSimulationSubsystem* Ballistics = GetWorld()->GetSubsystem<UBallisticSimulationSubsystem>())
 	{
-		Projectile->InitializeProjectile(AttackDamage, DetectRange, 1.0f);
+		// Shots carry as far as the enemy can see (DetectRange is in cm, the range in meters)
+		Ballistics->FireProjectile(ProjectileClass, SpawnLoc, SpawnRot, this, GetInstigator(), AttackDamage, DetectRange / 100.0f, 1.0f);
 	}
 }
 
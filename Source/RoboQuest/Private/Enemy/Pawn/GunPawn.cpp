@@ -2,9 +2,11 @@
 
 #include "Enemy/Pawn/GunPawn.h"
 #include "../../../RoboQuestProjectile.h"
+#include "Subsystems/ProjectilePoolSubsystem.h"
+#include "Subsystems/BallisticSimulationSubsystem.h"
 #include "Components/StatusComponent.h"
 #include "Components/SkeletalMeshComponent.h"
-#include "TimerManager.h"
+#include "Subsystems/EnemyAttackSchedulerSubsystem.h"
 #include "Engine/World.h"
 #include "Animation/AnimInstance.h"
 
@@ -30,16 +32,11 @@ void AGunPawn::BeginPlay()
 		StatusComponent->InitializeEnemyStats(TEXT("GunPawn"), 1);
 	}
 
-	// Start the firing loop (Calls TryFire periodically)
-	GetWorld()->GetTimerManager().SetTimer(FireLoopTimerHandle, this, &AGunPawn::TryFire, FireRate, true);
-}
-
-void AGunPawn::EndPlay(const EEndPlayReason::Type EndPlayReason)
-{
-	Super::EndPlay(EndPlayReason);
-	
-	GetWorld()->GetTimerManager().ClearTimer(FireLoopTimerHandle);
-	GetWorld()->GetTimerManager().ClearTimer(AttackSequenceTimerHandle);
+	// Make sure our projectiles are pooled before the first shot
+	if (UProjectilePoolSubsystem* Pool = GetWorld()->GetSubsystem<UProjectilePoolSubsystem>())
+	{
+		Pool->PrewarmPool(ProjectileClass, Pool->DefaultPrewarmCount);
+	}
 }
 
 float AGunPawn::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
@@ -55,29 +52,39 @@ float AGunPawn::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent,
 	return ActualDamage;
 }
 
+void AGunPawn::ResetForReuse(const FVector& Location, const FRotator& Rotation)
+{
+	Super::ResetForReuse(Location, Rotation);
+
+	bIsAttacking = false;
+}
+
 void AGunPawn::PlayHit()
 {
 	if (HitMontage && GetMesh() && GetMesh()->GetAnimInstance())
 	{
 		// Interrupt attack
-		GetWorld()->GetTimerManager().ClearTimer(AttackSequenceTimerHandle);
+		if (UEnemyAttackSchedulerSubsystem* Attacks = GetWorld()->GetSubsystem<UEnemyAttackSchedulerSubsystem>())
+		{
+			Attacks->CancelTelegraph(this);
+		}
 		bIsAttacking = false;
 
 		GetMesh()->GetAnimInstance()->Montage_Play(HitMontage);
 	}
 }
 
-void AGunPawn::TryFire()
+float AGunPawn::TryBeginAttack()
 {
 	// Don't fire if dead, no target, can't see target, or already attacking
 	if (!IsAlive() || !HasValidTarget() || !CanSeeTarget() || bIsAttacking)
 	{
-		return;
+		return -1.0f;
 	}
 
 	// Check distance - only fire if within effective range
 	float Dist = FVector::Dist(GetActorLocation(), GetTarget()->GetActorLocation());
-	if (Dist > DetectRange) return;
+	if (Dist > DetectRange) return -1.0f;
 
 	bIsAttacking = true;
 
@@ -88,15 +95,8 @@ void AGunPawn::TryFire()
 		PreShootDuration = GetMesh()->GetAnimInstance()->Montage_Play(PreShootMontage);
 	}
 
-	// Schedule Shoot
-	if (PreShootDuration > 0.0f)
-	{
-		GetWorld()->GetTimerManager().SetTimer(AttackSequenceTimerHandle, this, &AGunPawn::PerformShoot, PreShootDuration, false);
-	}
-	else
-	{
-		PerformShoot();
-	}
+	// The scheduler calls PerformShoot once the PreShoot is over (right away if there is none)
+	return PreShootDuration;
 }
 
 void AGunPawn::PerformShoot()
@@ -142,17 +142,11 @@ void AGunPawn::FireProjectile()
 		SpawnLoc += GetActorForwardVector() * 50.0f + FVector(0,0,50.0f);
 	}
 
-	FActorSpawnParameters ActorSpawnParams;
-	ActorSpawnParams.Owner = this;
-	ActorSpawnParams.Instigator = GetInstigator();
-	ActorSpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-
-	ARoboQuestProjectile* Projectile = GetWorld()->SpawnActor<ARoboQuestProjectile>(ProjectileClass, SpawnLoc, SpawnRot, ActorSpawnParams);
-
-	if (Projectile)
+	// Simulated centrally or taken from the projectile pool, depending on the projectile class
+	if (UBallisticSimulationSubsystem* Ballistics = GetWorld()->GetSubsystem<UBallisticSimulationSubsystem>())
 	{
-		// Pass damage and range
-		Projectile->InitializeProjectile(AttackDamage, DetectRange, 1.0f);
+		// Shots carry as far as the enemy can see (DetectRange is in cm, the range in meters)
+		Ballistics->FireProjectile(ProjectileClass, SpawnLoc, SpawnRot, this, GetInstigator(), AttackDamage, DetectRange / 100.0f, 1.0f);
 	}
 }
 
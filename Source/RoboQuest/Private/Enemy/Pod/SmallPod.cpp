@@ -2,8 +2,10 @@
 
 #include "Enemy/Pod/SmallPod.h"
 #include "../../../RoboQuestProjectile.h"
+#include "Subsystems/ProjectilePoolSubsystem.h"
+#include "Subsystems/BallisticSimulationSubsystem.h"
 #include "Components/SkeletalMeshComponent.h"
-#include "TimerManager.h"
+#include "Subsystems/EnemyAttackSchedulerSubsystem.h"
 #include "Engine/World.h"
 #include "Animation/AnimInstance.h"
 
@@ -22,17 +24,11 @@ void ASmallPod::BeginPlay()
 		StatusComponent->InitializeEnemyStats(TEXT("SmallPod"), 1);
 	}
 
-	// Start the firing loop (Calls TryFire periodically)
-	GetWorld()->GetTimerManager().SetTimer(FireLoopTimerHandle, this, &ASmallPod::TryFire, FireRate, true);
-}
-
-void ASmallPod::EndPlay(const EEndPlayReason::Type EndPlayReason)
-{
-	Super::EndPlay(EndPlayReason);
-
-	// Clear all timers
-	GetWorld()->GetTimerManager().ClearTimer(FireLoopTimerHandle);
-	GetWorld()->GetTimerManager().ClearTimer(AttackSequenceTimerHandle);
+	// Make sure our projectiles are pooled before the first shot
+	if (UProjectilePoolSubsystem* Pool = GetWorld()->GetSubsystem<UProjectilePoolSubsystem>())
+	{
+		Pool->PrewarmPool(ProjectileClass, Pool->DefaultPrewarmCount);
+	}
 }
 
 float ASmallPod::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
@@ -48,12 +44,22 @@ float ASmallPod::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent,
 	return ActualDamage;
 }
 
+void ASmallPod::ResetForReuse(const FVector& Location, const FRotator& Rotation)
+{
+	Super::ResetForReuse(Location, Rotation);
+
+	bIsAttacking = false;
+}
+
 void ASmallPod::PlayHit()
 {
 	if (HitMontage && GetMesh() && GetMesh()->GetAnimInstance())
 	{
 		// Interrupt any ongoing attack sequence
-		GetWorld()->GetTimerManager().ClearTimer(AttackSequenceTimerHandle);
+		if (UEnemyAttackSchedulerSubsystem* Attacks = GetWorld()->GetSubsystem<UEnemyAttackSchedulerSubsystem>())
+		{
+			Attacks->CancelTelegraph(this);
+		}
 		bIsAttacking = false;
 
 		// Play Stagger Montage
@@ -61,12 +67,12 @@ void ASmallPod::PlayHit()
 	}
 }
 
-void ASmallPod::TryFire()
+float ASmallPod::TryBeginAttack()
 {
 	// Conditions: Alive, Valid Target, Line of Sight, and Not already attacking
 	if (!IsAlive() || !HasValidTarget() || !CanSeeTarget() || bIsAttacking)
 	{
-		return;
+		return -1.0f;
 	}
 
 	bIsAttacking = true;
@@ -78,16 +84,8 @@ void ASmallPod::TryFire()
 		PreShootDuration = GetMesh()->GetAnimInstance()->Montage_Play(PreShootMontage);
 	}
 
-	// Set Timer to trigger PerformShoot after PreShoot finishes
-	// If duration is 0 (no montage), fire immediately
-	if (PreShootDuration > 0.0f)
-	{
-		GetWorld()->GetTimerManager().SetTimer(AttackSequenceTimerHandle, this, &ASmallPod::PerformShoot, PreShootDuration, false);
-	}
-	else
-	{
-		PerformShoot();
-	}
+	// The scheduler calls PerformShoot once the PreShoot is over (right away if there is none)
+	return PreShootDuration;
 }
 
 void ASmallPod::PerformShoot()
@@ -126,17 +124,10 @@ void ASmallPod::FireProjectile()
 		SpawnLoc += GetActorForwardVector() * 30.0f;
 	}
 
-	FActorSpawnParameters ActorSpawnParams;
-	ActorSpawnParams.Owner = this;
-	ActorSpawnParams.Instigator = GetInstigator();
-	
-	// Always spawn collision handling
-	ActorSpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-
-	ARoboQuestProjectile* Projectile = GetWorld()->SpawnActor<ARoboQuestProjectile>(ProjectileClass, SpawnLoc, SpawnRot, ActorSpawnParams);
-	
-	if (Projectile)
+	// Simulated centrally or taken from the projectile pool, depending on the projectile class
+	if (UBallisticSimulationSubsystem* Ballistics = GetWorld()->GetSubsystem<UBallisticSimulationSubsystem>())
 	{
-		Projectile->InitializeProjectile(AttackDamage, DetectRange, 1.0f);
+		// Shots carry as far as the enemy can see (DetectRange is in cm, the range in meters)
+		Ballistics->FireProjectile(ProjectileClass, SpawnLoc, SpawnRot, this, GetInstigator(), AttackDamage, DetectRange / 100.0f, 1.0f);
 	}
 }
\ No newline at end of file
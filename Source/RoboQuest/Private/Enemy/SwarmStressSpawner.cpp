@@ -0,0 +1,34 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Enemy/SwarmStressSpawner.h"
+#include "Enemy/EnemyBase.h"
+#include "Subsystems/SwarmSubsystem.h"
+#include "Engine/World.h"
+
+ASwarmStressSpawner::ASwarmStressSpawner()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+}
+
+void ASwarmStressSpawner::BeginPlay()
+{
+	Super::BeginPlay();
+
+	USwarmSubsystem* Swarm = GetWorld()->GetSubsystem<USwarmSubsystem>();
+	if (!Swarm || !EnemyClass) return;
+
+	const FVector Origin = GetActorLocation();
+	for (int32 i = 0; i < Count; i++)
+	{
+		// Uniform over the disc
+		const float Angle = FMath::FRandRange(0.0f, 2.0f * PI);
+		const float Dist = Radius * FMath::Sqrt(FMath::FRand());
+		const FVector Location = Origin + FVector(FMath::Cos(Angle) * Dist, FMath::Sin(Angle) * Dist, FMath::FRandRange(HeightRange.X, HeightRange.Y));
+
+		Swarm->AddSwarmEntity(EnemyClass, Location, FRotator(0.0f, FMath::RadiansToDegrees(Angle), 0.0f));
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("ASwarmStressSpawner:: %s added %d %s swarm entities"), *GetName(), Count, *GetNameSafe(EnemyClass));
+}
@@ -3,7 +3,8 @@
 
 #include "Gatlingbot.h"
 #include "Kismet/KismetMathLibrary.h"
-#include "Kismet/GameplayStatics.h"
+#include "Subsystems/LineOfSightSubsystem.h"
+#include "Subsystems/EnemyDebugDrawSubsystem.h"
 
 // Sets default values
 AGatlingbot::AGatlingbot()
@@ -40,28 +41,16 @@ bool AGatlingbot::CanSeeActor(AActor* TargetActor) const
 		return false;
 	}
 
-	// save line trace result
-	FHitResult Hit;
+	// last known visibility from the shared, time-sliced LOS service (no inline trace)
+	ULineOfSightSubsystem* LineOfSight = GetWorld()->GetSubsystem<ULineOfSightSubsystem>();
+	const bool bVisible = LineOfSight && LineOfSight->HasLineOfSight(this, TargetActor);
 
-	// set start and end location
-	FVector Start = GetActorLocation();
-	FVector End = TargetActor->GetActorLocation();
+#if ENABLE_DRAW_DEBUG
+	// debug line (rq.Debug.LOS)
+	UEnemyDebugDrawSubsystem::DrawLine(this, EEnemyDebugCategory::LOS, GetActorLocation(), TargetActor->GetActorLocation(), bVisible ? FColor::Green : FColor::Red);
+#endif
 
-	// only operate on Visible channel
-	ECollisionChannel Channel = ECC_Visibility;
-
-	// parameters to add to line trace
-	FCollisionQueryParams CollisionQueryParams;
-	CollisionQueryParams.AddIgnoredActor(this); // ignore self
-
-	// debug line
-	DrawDebugLine(GetWorld(), Start, End, FColor::Red);
-
-	// execute line trace
-
-	GetWorld()->LineTraceSingleByChannel(Hit, Start, End, Channel, CollisionQueryParams);
-
-	return !Hit.IsValidBlockingHit();
+	return bVisible;
 }
 
 bool AGatlingbot::LookAtActor(AActor* TargetActor)
@@ -99,10 +88,8 @@ void AGatlingbot::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	// Find the player character in the world
-	ACharacter* CurrentPlayerCharacter = UGameplayStatics::GetPlayerCharacter(this, 0);
-
-	bCanSeeTarget = LookAtActor(CurrentPlayerCharacter);
+	// Target resolved by AEnemyBotBase::FindTarget (shared UTargetingSubsystem)
+	bCanSeeTarget = LookAtActor(CurrentTarget);
 
 
 
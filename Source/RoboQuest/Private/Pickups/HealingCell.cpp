@@ -3,16 +3,18 @@
 #include "Pickups/HealingCell.h"
 #include "Components/StaticMeshComponent.h"
 #include "Components/SphereComponent.h"
-#include "Kismet/GameplayStatics.h"
+#include "Subsystems/TargetingSubsystem.h"
+#include "Subsystems/PickupSubsystem.h"
 #include "GameFramework/Character.h"
 #include "RoboQuest/RoboQuestCharacter.h"
 #include "Components/StatusComponent.h"
+#include "TimerManager.h"
 
 // Sets default values
 AHealingCell::AHealingCell()
 {
- 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+	// No tick: the pop is checked on a timer, then UPickupSubsystem moves the cell
+	PrimaryActorTick.bCanEverTick = false;
 
 	// Collision Sphere (Trigger)
 	MeshComponent = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("MeshComp"));
@@ -48,50 +50,90 @@ void AHealingCell::BeginPlay()
 		RandomDir.Z = FMath::Abs(RandomDir.Z) + 0.5f; // Bias upwards
 		MeshComponent->AddImpulse(RandomDir * SpawnImpulseStrength, NAME_None, true);
 	}
+
+	GetWorldTimerManager().SetTimer(HandOffTimer, this, &AHealingCell::CheckPopFinished, 0.25f, true);
+
+	// Open to merges from drops landing nearby
+	SpawnTime = GetWorld()->GetTimeSeconds();
+	if (UPickupSubsystem* Pickups = GetWorld()->GetSubsystem<UPickupSubsystem>())
+	{
+		Pickups->RegisterPoppingCell(this);
+	}
 }
 
-// Called every frame
-void AHealingCell::Tick(float DeltaTime)
+void AHealingCell::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::Tick(DeltaTime);
+	if (UPickupSubsystem* Pickups = GetWorld()->GetSubsystem<UPickupSubsystem>())
+	{
+		Pickups->UnregisterPoppingCell(this);
+	}
 
-	// If consumed, stop logic (just in case Destroy hasn't happened yet)
-	if (bIsConsumed) return;
+	Super::EndPlay(EndPlayReason);
+}
+
+void AHealingCell::AddToStack(float InHealAmount, int32 InStackCount)
+{
+	const int32 OldStackCount = StackCount;
+	HealAmount += InHealAmount;
+	StackCount += InStackCount;
 
-	// Find Player if not already found (optimization: cache usually done in BeginPlay, but player 0 is safe)
-	if (!TargetPlayer)
+	// Visual stack count: custom primitive data 0 for the material, and a bigger cell
+	MeshComponent->SetCustomPrimitiveDataFloat(0, (float)StackCount);
+	if (const UPickupSubsystem* Pickups = GetWorld()->GetSubsystem<UPickupSubsystem>())
 	{
-		TargetPlayer = UGameplayStatics::GetPlayerCharacter(this, 0);
+		SetActorScale3D(GetActorScale3D() * (Pickups->GetStackScale(StackCount) / Pickups->GetStackScale(OldStackCount)));
 	}
+}
 
-	if (TargetPlayer)
+void AHealingCell::CheckPopFinished()
+{
+	if (bIsConsumed) return;
+
+	UPickupSubsystem* Pickups = GetWorld()->GetSubsystem<UPickupSubsystem>();
+	if (!Pickups) return;
+
+	// Still bouncing, and no player close enough to pull it in yet
+	const bool bPopping = MeshComponent->IsSimulatingPhysics() && MeshComponent->RigidBodyIsAwake() && GetGameTimeSinceCreation() < MaxPopDuration;
+	if (bPopping)
 	{
-		float DistSq = FVector::DistSquared(GetActorLocation(), TargetPlayer->GetActorLocation());
-		float RangeSq = MagnetDetectRange * MagnetDetectRange;
-
-		// 1. Check Magnet Condition
-		if (!bIsMagnetized && DistSq <= RangeSq)
-		{
-			bIsMagnetized = true;
-			
-			// Disable physics so we can manually move it to the player
-			if (MeshComponent)
-			{
-				MeshComponent->SetSimulatePhysics(false);
-				MeshComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision); // Prevent getting stuck on walls while flying
-			}
-		}
-
-		// 2. Execute Homing Movement
-		if (bIsMagnetized)
-		{
-			FVector CurrentLoc = GetActorLocation();
-			FVector TargetLoc = TargetPlayer->GetActorLocation() + FVector(0,0, 50.0f); // Aim for chest/center
-
-			FVector NewLoc = FMath::VInterpConstantTo(CurrentLoc, TargetLoc, DeltaTime, MagnetFlySpeed);
-			SetActorLocation(NewLoc);
-		}
+		const UTargetingSubsystem* Targeting = GetWorld()->GetSubsystem<UTargetingSubsystem>();
+		if (!Targeting || !Targeting->FindNearestTarget(GetActorLocation(), MagnetDetectRange)) return;
 	}
+
+	// Out of the merge list first, so the cell does not merge into itself
+	Pickups->UnregisterPoppingCell(this);
+
+	FHealingCellPickup Cell;
+	Cell.Location = GetActorLocation();
+	Cell.Rotation = GetActorRotation();
+	Cell.HealAmount = HealAmount;
+	Cell.StackCount = StackCount;
+	Cell.SpawnTime = SpawnTime;
+	Cell.MagnetDetectRange = MagnetDetectRange;
+	Cell.MagnetFlySpeed = MagnetFlySpeed;
+	Cell.CollectRadius = SphereComponent->GetScaledSphereRadius();
+	// Unstacked scale for the instances, the stack scale is applied per instance
+	Pickups->AddHealingCell(Cell, MeshComponent->GetStaticMesh(), MeshComponent->GetComponentScale() / Pickups->GetStackScale(StackCount));
+
+	bIsConsumed = true;
+	GetWorldTimerManager().ClearTimer(HandOffTimer);
+	Destroy();
+}
+
+bool AHealingCell::HealCollector(AActor* Collector, float HealAmount)
+{
+	// Only interact with Player Character
+	ARoboQuestCharacter* PlayerChar = Cast<ARoboQuestCharacter>(Collector);
+	UStatusComponent* Status = PlayerChar ? PlayerChar->GetStatusComponent() : nullptr;
+	if (!Status) return false;
+
+	Status->Heal(HealAmount);
+
+	// Visual FX / Sound can be added here
+	// UGameplayStatics::SpawnEmitterAtLocation(...)
+	// UGameplayStatics::PlaySoundAtLocation(...)
+
+	return true;
 }
 
 void AHealingCell::OnOverlapBegin(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
@@ -99,23 +141,10 @@ void AHealingCell::OnOverlapBegin(UPrimitiveComponent* OverlappedComp, AActor* O
 	// Prevent double triggering
 	if (bIsConsumed) return;
 
-	// Only interact with Player Character
-	ARoboQuestCharacter* PlayerChar = Cast<ARoboQuestCharacter>(OtherActor);
-	if (PlayerChar)
+	// Player walked into the cell while it was still popping: the whole stack in one heal
+	if (HealCollector(OtherActor, HealAmount))
 	{
-		// Heal Logic
-		if (UStatusComponent* Status = PlayerChar->GetStatusComponent())
-		{
-			bIsConsumed = true;
-
-			Status->Heal(HealAmount);
-			
-			// Visual FX / Sound can be added here
-			// UGameplayStatics::SpawnEmitterAtLocation(...)
-			// UGameplayStatics::PlaySoundAtLocation(...)
-			
-			Destroy();
-		}
+		bIsConsumed = true;
+		Destroy();
 	}
 }
-
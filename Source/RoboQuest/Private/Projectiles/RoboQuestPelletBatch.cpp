@@ -0,0 +1,213 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Projectiles/RoboQuestPelletBatch.h"
+#include "RoboQuest/RoboQuestProjectile.h"
+#include "RoboQuest/RoboQuest.h"
+#include "Subsystems/ProjectilePoolSubsystem.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/World.h"
+
+ARoboQuestPelletBatch::ARoboQuestPelletBatch()
+{
+	PrimaryActorTick.bCanEverTick = true;
+
+	// Render-only instances; hits are resolved by our own sweeps
+	PelletMeshes = CreateDefaultSubobject<UInstancedStaticMeshComponent>(TEXT("PelletMeshes"));
+	PelletMeshes->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	PelletMeshes->SetCastShadow(false);
+	RootComponent = PelletMeshes;
+
+	// Die after 3 seconds when no range is given (same as ARoboQuestProjectile)
+	InitialLifeSpan = 3.0f;
+}
+
+void ARoboQuestPelletBatch::InitializePellets(const FVector& Origin, const TArray<FVector>& Directions, float NewDamage, float NewRange, float NewCritMul)
+{
+	Damage = NewDamage;
+	RangeMeter = NewRange;
+	CritDamageMultiplier = NewCritMul;
+
+	// Range in meters -> distance budget in cm; the lifespan is only a fallback without range
+	MaxTravelDistance = FMath::Max(0.0f, RangeMeter * 100.0f);
+	if (MaxTravelDistance > 0.0f)
+	{
+		SetLifeSpan(0.0f);
+	}
+
+	Pellets.SetNum(Directions.Num());
+	for (int32 i = 0; i < Directions.Num(); i++)
+	{
+		Pellets[i].Location = Origin;
+		Pellets[i].Velocity = Directions[i].GetSafeNormal() * PelletSpeed;
+		Pellets[i].TravelledDistance = 0.0f;
+		Pellets[i].bAlive = true;
+	}
+	NumAlivePellets = Pellets.Num();
+	INC_DWORD_STAT_BY(STAT_LiveProjectiles, NumAlivePellets);
+
+	// One instance per pellet, placed in world space
+	PelletMeshes->ClearInstances();
+	for (const FRoboQuestPellet& Pellet : Pellets)
+	{
+		PelletMeshes->AddInstance(FTransform(Pellet.Velocity.Rotation(), Pellet.Location, PelletMeshScale), true);
+	}
+}
+
+void ARoboQuestPelletBatch::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	UWorld* World = GetWorld();
+	if (!World || NumAlivePellets <= 0) return;
+
+	const float GravityZ = World->GetGravityZ() * GravityScale;
+	const FCollisionShape Shape = FCollisionShape::MakeSphere(PelletRadius);
+
+	// Shared query params for the whole batch: ignore ourselves and the shooter
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(PelletBatch), false, this);
+	if (GetOwner())
+	{
+		Params.AddIgnoredActor(GetOwner());
+	}
+
+	// One pass over all pellets: integrate, sweep, apply damage, check range
+	for (FRoboQuestPellet& Pellet : Pellets)
+	{
+		if (!Pellet.bAlive) continue;
+
+		Pellet.Velocity.Z += GravityZ * DeltaTime;
+
+		const FVector Start = Pellet.Location;
+		FVector End = Start + Pellet.Velocity * DeltaTime;
+
+		// Clamp the last step to the remaining range so a pellet never hits beyond it
+		bool bOutOfRange = false;
+		if (MaxTravelDistance > 0.0f)
+		{
+			const float StepLength = FVector::Dist(Start, End);
+			const float Remaining = MaxTravelDistance - Pellet.TravelledDistance;
+			if (StepLength >= Remaining)
+			{
+				End = Start + (End - Start) * (Remaining / FMath::Max(StepLength, KINDA_SMALL_NUMBER));
+				bOutOfRange = true;
+			}
+			Pellet.TravelledDistance += FMath::Min(StepLength, Remaining);
+		}
+
+		FHitResult Hit;
+		if (World->SweepSingleByProfile(Hit, Start, End, FQuat::Identity, CollisionProfileName, Shape, Params))
+		{
+			Pellet.Location = Hit.Location;
+			RetirePellet(Pellet);
+
+			ARoboQuestProjectile::ApplyProjectileDamage(this, GetOwner(), GetInstigatorController(), Hit.GetActor(), Damage);
+		}
+		else
+		{
+			Pellet.Location = End;
+			if (bOutOfRange)
+			{
+				RetirePellet(Pellet);
+			}
+		}
+	}
+
+	if (NumAlivePellets <= 0)
+	{
+		RetireBatch();
+		return;
+	}
+
+	UpdatePelletInstances();
+}
+
+void ARoboQuestPelletBatch::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// Pellets still flying when the batch goes away (lifespan, level end) are retired with it
+	for (FRoboQuestPellet& Pellet : Pellets)
+	{
+		if (Pellet.bAlive)
+		{
+			RetirePellet(Pellet);
+		}
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ARoboQuestPelletBatch::ActivatePooledBatch(const FVector& Location, const FRotator& Rotation)
+{
+	bIsInFlight = true;
+
+	SetActorLocationAndRotation(Location, Rotation);
+	SetActorHiddenInGame(false);
+	SetActorTickEnabled(true);
+
+	// Restart the default lifespan (LifeSpanExpired returns us to the pool)
+	SetLifeSpan(InitialLifeSpan);
+}
+
+void ARoboQuestPelletBatch::DeactivatePooledBatch()
+{
+	bIsInFlight = false;
+
+	// Clear the lifespan timer
+	SetLifeSpan(0.0f);
+	SetActorTickEnabled(false);
+	SetActorHiddenInGame(true);
+
+	Pellets.Reset();
+	NumAlivePellets = 0;
+	PelletMeshes->ClearInstances();
+}
+
+void ARoboQuestPelletBatch::RetireBatch()
+{
+	for (FRoboQuestPellet& Pellet : Pellets)
+	{
+		if (Pellet.bAlive)
+		{
+			RetirePellet(Pellet);
+		}
+	}
+
+	if (bIsPooled)
+	{
+		if (UProjectilePoolSubsystem* Pool = GetWorld()->GetSubsystem<UProjectilePoolSubsystem>())
+		{
+			Pool->ReleasePelletBatch(this);
+			return;
+		}
+	}
+
+	Destroy();
+}
+
+void ARoboQuestPelletBatch::LifeSpanExpired()
+{
+	RetireBatch();
+}
+
+void ARoboQuestPelletBatch::RetirePellet(FRoboQuestPellet& Pellet)
+{
+	Pellet.bAlive = false;
+	NumAlivePellets--;
+
+	DEC_DWORD_STAT(STAT_LiveProjectiles);
+	INC_DWORD_STAT(STAT_ProjectileRetirements);
+}
+
+void ARoboQuestPelletBatch::UpdatePelletInstances()
+{
+	TArray<FTransform> Transforms;
+	Transforms.Reserve(Pellets.Num());
+
+	for (const FRoboQuestPellet& Pellet : Pellets)
+	{
+		// Dead pellets are collapsed instead of removed so instance indices stay stable
+		const FVector Scale = Pellet.bAlive ? PelletMeshScale : FVector::ZeroVector;
+		Transforms.Add(FTransform(Pellet.Velocity.Rotation(), Pellet.Location, Scale));
+	}
+
+	PelletMeshes->BatchUpdateInstancesTransforms(0, Transforms, true, true, true);
+}
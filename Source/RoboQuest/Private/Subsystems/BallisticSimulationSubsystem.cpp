@@ -0,0 +1,272 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/BallisticSimulationSubsystem.h"
+#include "Subsystems/ProjectilePoolSubsystem.h"
+#include "RoboQuest/RoboQuestProjectile.h"
+#include "RoboQuest/RoboQuest.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+#include "GameFramework/Pawn.h"
+#include "Components/SphereComponent.h"
+#include "Engine/World.h"
+
+void UBallisticSimulationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Positions.Reserve(InitialCapacity);
+	Velocities.Reserve(InitialCapacity);
+	RemainingRange.Reserve(InitialCapacity);
+	RemainingLife.Reserve(InitialCapacity);
+	Damages.Reserve(InitialCapacity);
+	CritMultipliers.Reserve(InitialCapacity);
+	GravityZ.Reserve(InitialCapacity);
+	Radii.Reserve(InitialCapacity);
+	CollisionProfiles.Reserve(InitialCapacity);
+	Owners.Reserve(InitialCapacity);
+	Instigators.Reserve(InitialCapacity);
+	VisualProxies.Reserve(InitialCapacity);
+	SweepEnds.Reserve(InitialCapacity);
+	PendingSweeps.Reserve(InitialCapacity);
+	RetireFlags.Reserve(InitialCapacity);
+}
+
+void UBallisticSimulationSubsystem::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_LiveProjectiles, Positions.Num());
+
+	Positions.Empty();
+	Velocities.Empty();
+	RemainingRange.Empty();
+	RemainingLife.Empty();
+	Damages.Empty();
+	CritMultipliers.Empty();
+	GravityZ.Empty();
+	Radii.Empty();
+	CollisionProfiles.Empty();
+	Owners.Empty();
+	Instigators.Empty();
+	VisualProxies.Empty();
+	SweepEnds.Empty();
+	PendingSweeps.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UBallisticSimulationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UBallisticSimulationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UBallisticSimulationSubsystem, STATGROUP_Tickables);
+}
+
+void UBallisticSimulationSubsystem::FireProjectile(TSubclassOf<ARoboQuestProjectile> ProjectileClass, const FVector& Location, const FRotator& Rotation, AActor* Shooter, APawn* ShooterInstigator, float Damage, float RangeMeter, float CritMul)
+{
+	if (!ProjectileClass) return;
+
+	UWorld* World = GetWorld();
+	UProjectilePoolSubsystem* Pool = World ? World->GetSubsystem<UProjectilePoolSubsystem>() : nullptr;
+
+	const ARoboQuestProjectile* Defaults = ProjectileClass.GetDefaultObject();
+	if (!Defaults->bSimulateCentrally)
+	{
+		// Regular projectile: pooled actor with its own movement component
+		ARoboQuestProjectile* Projectile = Pool ? Pool->AcquireProjectile(ProjectileClass, Location, Rotation, Shooter, ShooterInstigator) : nullptr;
+		if (Projectile)
+		{
+			Projectile->InitializeProjectile(Damage, RangeMeter, CritMul);
+		}
+		return;
+	}
+
+	// Read ballistic parameters from the class defaults
+	const UProjectileMovementComponent* DefaultMovement = Defaults->GetProjectileMovement();
+	const USphereComponent* DefaultCollision = Defaults->GetCollisionComp();
+
+	const float Speed = DefaultMovement ? DefaultMovement->InitialSpeed : 3000.0f;
+	const float GravityScale = DefaultMovement ? DefaultMovement->ProjectileGravityScale : 1.0f;
+
+	Positions.Add(Location);
+	Velocities.Add(Rotation.Vector() * Speed);
+	// The range is the budget; the class lifespan is only a fallback for shots without range
+	const bool bHasRange = RangeMeter > 0.0f;
+	RemainingRange.Add(bHasRange ? RangeMeter * 100.0f : TNumericLimits<float>::Max());
+	RemainingLife.Add(!bHasRange && Defaults->InitialLifeSpan > 0.0f ? Defaults->InitialLifeSpan : TNumericLimits<float>::Max());
+	Damages.Add(Damage);
+	CritMultipliers.Add(CritMul);
+	GravityZ.Add(World->GetGravityZ() * GravityScale);
+	Radii.Add(DefaultCollision ? DefaultCollision->GetUnscaledSphereRadius() : 5.0f);
+	CollisionProfiles.Add(DefaultCollision ? DefaultCollision->GetCollisionProfileName() : FName(TEXT("Projectile")));
+	Owners.Add(Shooter);
+	Instigators.Add(ShooterInstigator);
+
+	ARoboQuestProjectile* Proxy = nullptr;
+	if (Defaults->bSpawnVisualProxy && Pool)
+	{
+		Proxy = Pool->AcquireProjectile(ProjectileClass, Location, Rotation, Shooter, ShooterInstigator);
+		if (Proxy)
+		{
+			Proxy->ActivateAsVisualProxy(Location, Rotation);
+			Proxy->InitializeProjectile(Damage, RangeMeter, CritMul);
+		}
+	}
+	VisualProxies.Add(Proxy);
+	SweepEnds.Add(Location);
+	PendingSweeps.Add(FTraceHandle());
+
+	INC_DWORD_STAT(STAT_LiveProjectiles);
+}
+
+void UBallisticSimulationSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const int32 Num = Positions.Num();
+	if (Num == 0) return;
+
+	UWorld* World = GetWorld();
+
+	RetireFlags.SetNumZeroed(Num, EAllowShrinking::No);
+
+	// 1. Resolve the steps swept since the last pass: stop at the hit or commit the step
+	for (int32 i = 0; i < Num; i++)
+	{
+		if (!PendingSweeps[i].IsValid())
+		{
+			// Fired after the last pass, nothing swept yet
+			continue;
+		}
+
+		FHitResult Hit;
+		if (ResolveSweep(World, i, Hit))
+		{
+			Positions[i] = Hit.Location;
+			RetireFlags[i] = 1;
+
+			AActor* Shooter = Owners[i].Get();
+			APawn* ShooterInstigator = Instigators[i].Get();
+			AActor* DamageCauser = VisualProxies[i].IsValid() ? static_cast<AActor*>(VisualProxies[i].Get()) : Shooter;
+
+			ARoboQuestProjectile::ApplyProjectileDamage(DamageCauser, Shooter, ShooterInstigator ? ShooterInstigator->GetController() : nullptr, Hit.GetActor(), Damages[i]);
+		}
+		else
+		{
+			Positions[i] = SweepEnds[i];
+			RetireFlags[i] = (RemainingRange[i] <= 0.0f || RemainingLife[i] <= 0.0f) ? 1 : 0;
+		}
+
+		if (ARoboQuestProjectile* Proxy = VisualProxies[i].Get())
+		{
+			Proxy->SetActorLocationAndRotation(Positions[i], Velocities[i].Rotation());
+		}
+	}
+
+	// 2. Retire finished bullets (backwards so swaps only move already-processed entries)
+	for (int32 i = Num - 1; i >= 0; i--)
+	{
+		if (RetireFlags[i])
+		{
+			RemoveProjectileAt(i);
+		}
+	}
+
+	// 3. Integrate every remaining bullet in one linear pass over the buffers and queue the sweep of its step;
+	// the sweeps run in one batch at the end of the frame and are resolved by the next pass
+	for (int32 i = 0; i < Positions.Num(); i++)
+	{
+		Velocities[i].Z += GravityZ[i] * DeltaTime;
+
+		FVector Delta = Velocities[i] * DeltaTime;
+
+		// Clamp the last step to the remaining range so a bullet never hits beyond it
+		const float StepLength = Delta.Size();
+		if (StepLength > RemainingRange[i])
+		{
+			Delta *= RemainingRange[i] / StepLength;
+		}
+		SweepEnds[i] = Positions[i] + Delta;
+
+		RemainingRange[i] -= StepLength;
+		RemainingLife[i] -= DeltaTime;
+
+		RequestSweep(World, i);
+	}
+}
+
+FCollisionQueryParams UBallisticSimulationSubsystem::MakeQueryParams(int32 Index) const
+{
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(BallisticSimulation), false);
+	if (AActor* Shooter = Owners[Index].Get())
+	{
+		Params.AddIgnoredActor(Shooter);
+	}
+	if (ARoboQuestProjectile* Proxy = VisualProxies[Index].Get())
+	{
+		Params.AddIgnoredActor(Proxy);
+	}
+	return Params;
+}
+
+void UBallisticSimulationSubsystem::RequestSweep(UWorld* World, int32 Index)
+{
+	// Zero-radius bullets only need a ray
+	if (Radii[Index] <= 0.0f)
+	{
+		PendingSweeps[Index] = World->AsyncLineTraceByProfile(EAsyncTraceType::Single, Positions[Index], SweepEnds[Index], CollisionProfiles[Index], MakeQueryParams(Index));
+	}
+	else
+	{
+		PendingSweeps[Index] = World->AsyncSweepByProfile(EAsyncTraceType::Single, Positions[Index], SweepEnds[Index], FQuat::Identity, CollisionProfiles[Index], FCollisionShape::MakeSphere(Radii[Index]), MakeQueryParams(Index));
+	}
+}
+
+bool UBallisticSimulationSubsystem::ResolveSweep(UWorld* World, int32 Index, FHitResult& OutHit)
+{
+	FTraceDatum Datum;
+	if (World->QueryTraceData(PendingSweeps[Index], Datum))
+	{
+		for (const FHitResult& Hit : Datum.OutHits)
+		{
+			if (Hit.bBlockingHit)
+			{
+				OutHit = Hit;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	if (Radii[Index] <= 0.0f)
+	{
+		return World->LineTraceSingleByProfile(OutHit, Positions[Index], SweepEnds[Index], CollisionProfiles[Index], MakeQueryParams(Index));
+	}
+	return World->SweepSingleByProfile(OutHit, Positions[Index], SweepEnds[Index], FQuat::Identity, CollisionProfiles[Index], FCollisionShape::MakeSphere(Radii[Index]), MakeQueryParams(Index));
+}
+
+void UBallisticSimulationSubsystem::RemoveProjectileAt(int32 Index)
+{
+	if (ARoboQuestProjectile* Proxy = VisualProxies[Index].Get())
+	{
+		Proxy->RetireProjectile();
+	}
+
+	DEC_DWORD_STAT(STAT_LiveProjectiles);
+	INC_DWORD_STAT(STAT_ProjectileRetirements);
+
+	Positions.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Velocities.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	RemainingRange.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	RemainingLife.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Damages.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	CritMultipliers.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	GravityZ.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Radii.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	CollisionProfiles.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Owners.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Instigators.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	VisualProxies.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	SweepEnds.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	PendingSweeps.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
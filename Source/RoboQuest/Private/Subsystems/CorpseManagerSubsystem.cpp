@@ -0,0 +1,70 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/CorpseManagerSubsystem.h"
+#include "Enemy/EnemyBase.h"
+#include "RoboQuest/RoboQuest.h"
+
+void UCorpseManagerSubsystem::Deinitialize()
+{
+	Corpses.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UCorpseManagerSubsystem::RegisterCorpse(AEnemyBase* Enemy)
+{
+	if (!Enemy) return false;
+
+	Corpses.RemoveAll([](const FCorpseEntry& Entry) { return !Entry.Enemy.IsValid(); });
+
+	// Make room: recycle the oldest corpses (removed first, so their own unregister finds nothing)
+	while (Corpses.Num() > 0 && Corpses.Num() >= MaxCorpses)
+	{
+		AEnemyBase* Oldest = Corpses[0].Enemy.Get();
+		Corpses.RemoveAt(0, 1, EAllowShrinking::No);
+		Oldest->RetireCorpse();
+	}
+
+	FCorpseEntry& Entry = Corpses.AddDefaulted_GetRef();
+	Entry.Enemy = Enemy;
+	Entry.bSimulating = GetNumSimulatedRagdolls() < MaxSimulatedRagdolls;
+
+	UpdateStats();
+	return Entry.bSimulating;
+}
+
+void UCorpseManagerSubsystem::OnRagdollSettled(AEnemyBase* Enemy)
+{
+	if (FCorpseEntry* Entry = Corpses.FindByPredicate([Enemy](const FCorpseEntry& It) { return It.Enemy == Enemy; }))
+	{
+		Entry->bSimulating = false;
+		UpdateStats();
+	}
+}
+
+void UCorpseManagerSubsystem::UnregisterCorpse(AEnemyBase* Enemy)
+{
+	const int32 Index = Corpses.IndexOfByPredicate([Enemy](const FCorpseEntry& It) { return It.Enemy == Enemy; });
+	if (Index != INDEX_NONE)
+	{
+		// Keeps the order: oldest first
+		Corpses.RemoveAt(Index, 1, EAllowShrinking::No);
+		UpdateStats();
+	}
+}
+
+int32 UCorpseManagerSubsystem::GetNumSimulatedRagdolls() const
+{
+	int32 NumSimulating = 0;
+	for (const FCorpseEntry& Entry : Corpses)
+	{
+		NumSimulating += (Entry.bSimulating && Entry.Enemy.IsValid()) ? 1 : 0;
+	}
+	return NumSimulating;
+}
+
+void UCorpseManagerSubsystem::UpdateStats() const
+{
+	SET_DWORD_STAT(STAT_Corpses, Corpses.Num());
+	SET_DWORD_STAT(STAT_SimulatedRagdolls, GetNumSimulatedRagdolls());
+}
@@ -0,0 +1,157 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/EnemyAttackSchedulerSubsystem.h"
+#include "Enemy/EnemyBase.h"
+#include "Engine/World.h"
+
+void UEnemyAttackSchedulerSubsystem::Deinitialize()
+{
+	Entries.Empty();
+	DueAttacks.Empty();
+	DueShots.Empty();
+	NumActiveTelegraphs = 0;
+
+	Super::Deinitialize();
+}
+
+bool UEnemyAttackSchedulerSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UEnemyAttackSchedulerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyAttackSchedulerSubsystem, STATGROUP_Tickables);
+}
+
+UEnemyAttackSchedulerSubsystem::FAttackEntry* UEnemyAttackSchedulerSubsystem::FindEntry(const AEnemyBase* Enemy)
+{
+	return Entries.FindByPredicate([Enemy](const FAttackEntry& It) { return It.Enemy == Enemy; });
+}
+
+void UEnemyAttackSchedulerSubsystem::RegisterAttacker(AEnemyBase* Enemy, float AttackInterval)
+{
+	if (!Enemy || AttackInterval <= 0.0f) return;
+
+	FAttackEntry* Entry = FindEntry(Enemy);
+	if (!Entry)
+	{
+		Entry = &Entries.AddDefaulted_GetRef();
+		Entry->Enemy = Enemy;
+	}
+
+	Entry->AttackInterval = AttackInterval;
+	Entry->NextAttackTime = GetWorld()->GetTimeSeconds() + AttackInterval * FMath::FRandRange(0.5f, 1.5f);
+}
+
+void UEnemyAttackSchedulerSubsystem::UnregisterAttacker(AEnemyBase* Enemy)
+{
+	const int32 Index = Entries.IndexOfByPredicate([Enemy](const FAttackEntry& It) { return It.Enemy == Enemy; });
+	if (Index == INDEX_NONE) return;
+
+	if (Entries[Index].bTelegraphing)
+	{
+		NumActiveTelegraphs--;
+	}
+
+	Entries.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+void UEnemyAttackSchedulerSubsystem::CancelTelegraph(AEnemyBase* Enemy)
+{
+	FAttackEntry* Entry = FindEntry(Enemy);
+	if (Entry && Entry->bTelegraphing)
+	{
+		Entry->bTelegraphing = false;
+		NumActiveTelegraphs--;
+	}
+}
+
+void UEnemyAttackSchedulerSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Drop enemies destroyed without unregistering
+	for (int32 i = Entries.Num() - 1; i >= 0; i--)
+	{
+		if (!Entries[i].Enemy.IsValid())
+		{
+			if (Entries[i].bTelegraphing)
+			{
+				NumActiveTelegraphs--;
+			}
+			Entries.RemoveAtSwap(i, 1, EAllowShrinking::No);
+		}
+	}
+
+	if (Entries.Num() == 0) return;
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	// One linear pass: finished telegraphs and due attacks
+	DueAttacks.Reset();
+	DueShots.Reset();
+	for (int32 i = 0; i < Entries.Num(); i++)
+	{
+		FAttackEntry& Entry = Entries[i];
+		if (Entry.bTelegraphing)
+		{
+			if (Now >= Entry.ShootTime)
+			{
+				Entry.bTelegraphing = false;
+				NumActiveTelegraphs--;
+				DueShots.Add(Entry.Enemy);
+			}
+		}
+		else if (Now >= Entry.NextAttackTime)
+		{
+			DueAttacks.Add(i);
+		}
+	}
+
+	// Longest waiting first, so enemies held back by the caps get their turn
+	DueAttacks.Sort([this](int32 A, int32 B) { return Entries[A].NextAttackTime < Entries[B].NextAttackTime; });
+
+	int32 NumStarted = 0;
+	for (const int32 Index : DueAttacks)
+	{
+		if (NumStarted >= MaxAttackStartsPerFrame || NumActiveTelegraphs >= MaxConcurrentTelegraphs)
+		{
+			break;
+		}
+
+		FAttackEntry& Entry = Entries[Index];
+		AEnemyBase* Enemy = Entry.Enemy.Get();
+
+		// The cadence goes on whether the attempt succeeds or not (no target, no line of sight...)
+		Entry.NextAttackTime = Now + Entry.AttackInterval;
+
+		const float TelegraphDuration = Enemy->TryBeginAttack();
+		if (TelegraphDuration < 0.0f)
+		{
+			continue;
+		}
+
+		NumStarted++;
+
+		if (TelegraphDuration > 0.0f)
+		{
+			Entry.bTelegraphing = true;
+			Entry.ShootTime = Now + TelegraphDuration;
+			NumActiveTelegraphs++;
+		}
+		else
+		{
+			DueShots.Add(Entry.Enemy);
+		}
+	}
+
+	// Shots last: they spawn projectiles and must not run while we iterate Entries
+	for (const TWeakObjectPtr<AEnemyBase>& Shooter : DueShots)
+	{
+		if (AEnemyBase* Enemy = Shooter.Get())
+		{
+			Enemy->PerformShoot();
+		}
+	}
+}
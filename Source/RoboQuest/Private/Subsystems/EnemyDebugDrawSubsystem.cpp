@@ -0,0 +1,92 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/EnemyDebugDrawSubsystem.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/World.h"
+
+#if ENABLE_DRAW_DEBUG
+static TAutoConsoleVariable<bool> CVarEnemyDebugLOS(
+	TEXT("rq.Debug.LOS"), false,
+	TEXT("Draw enemy line-of-sight checks (green = visible, red = blocked)."));
+
+static TAutoConsoleVariable<bool> CVarEnemyDebugAvoidance(
+	TEXT("rq.Debug.Avoidance"), false,
+	TEXT("Draw the ground and wall probes of flying enemy obstacle avoidance."));
+
+static TAutoConsoleVariable<bool> CVarEnemyDebugHover(
+	TEXT("rq.Debug.Hover"), false,
+	TEXT("Draw the hover direction of flying enemies."));
+
+static TAutoConsoleVariable<bool> CVarEnemyDebugStrafe(
+	TEXT("rq.Debug.Strafe"), false,
+	TEXT("Draw the combat move (range keeping + strafe) direction of grounded enemies."));
+#endif
+
+void UEnemyDebugDrawSubsystem::Deinitialize()
+{
+	PendingLines.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UEnemyDebugDrawSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UEnemyDebugDrawSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyDebugDrawSubsystem, STATGROUP_Tickables);
+}
+
+bool UEnemyDebugDrawSubsystem::IsCategoryEnabled(EEnemyDebugCategory Category)
+{
+#if ENABLE_DRAW_DEBUG
+	switch (Category)
+	{
+	case EEnemyDebugCategory::LOS:			return CVarEnemyDebugLOS.GetValueOnGameThread();
+	case EEnemyDebugCategory::Avoidance:	return CVarEnemyDebugAvoidance.GetValueOnGameThread();
+	case EEnemyDebugCategory::Hover:		return CVarEnemyDebugHover.GetValueOnGameThread();
+	case EEnemyDebugCategory::Strafe:		return CVarEnemyDebugStrafe.GetValueOnGameThread();
+	}
+#endif
+	return false;
+}
+
+void UEnemyDebugDrawSubsystem::DrawLine(const UObject* WorldContextObject, EEnemyDebugCategory Category, const FVector& Start, const FVector& End, const FColor& Color, float Thickness)
+{
+	// Cheap early out before touching the world: categories are off most of the time
+	if (!IsCategoryEnabled(Category) || !WorldContextObject) return;
+
+	const UWorld* World = WorldContextObject->GetWorld();
+	if (UEnemyDebugDrawSubsystem* DebugDraw = World ? World->GetSubsystem<UEnemyDebugDrawSubsystem>() : nullptr)
+	{
+		DebugDraw->AddLine(Category, Start, End, Color, Thickness);
+	}
+}
+
+void UEnemyDebugDrawSubsystem::AddLine(EEnemyDebugCategory Category, const FVector& Start, const FVector& End, const FColor& Color, float Thickness)
+{
+	if (!IsCategoryEnabled(Category)) return;
+
+	// Lifetime 0: visible for one frame, like a non-persistent DrawDebugLine
+	PendingLines.Emplace(Start, End, FLinearColor(Color), 0.0f, Thickness, SDPG_World);
+}
+
+void UEnemyDebugDrawSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (PendingLines.Num() == 0) return;
+
+#if ENABLE_DRAW_DEBUG
+	// One submission for every enemy line of the frame
+	UWorld* World = GetWorld();
+	if (World && World->LineBatcher)
+	{
+		World->LineBatcher->DrawLines(PendingLines);
+	}
+#endif
+
+	PendingLines.Reset();
+}
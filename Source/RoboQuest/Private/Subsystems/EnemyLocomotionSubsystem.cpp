@@ -0,0 +1,310 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/EnemyLocomotionSubsystem.h"
+#include "Subsystems/EnemyDebugDrawSubsystem.h"
+#include "Enemy/EnemyBase.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Engine/World.h"
+
+namespace EnemyLocomotion
+{
+	enum EFlags : uint8
+	{
+		Rotate = 1 << 0,
+		Move = 1 << 1,
+	};
+}
+
+void FEnemyLocomotionTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Subsystem)
+	{
+		Subsystem->ProcessBatch();
+	}
+}
+
+FString FEnemyLocomotionTickFunction::DiagnosticMessage()
+{
+	return TEXT("UEnemyLocomotionSubsystem::LocomotionTick");
+}
+
+void UEnemyLocomotionSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	LocomotionTick.Subsystem = this;
+	LocomotionTick.TickGroup = TG_PrePhysics;
+	LocomotionTick.bCanEverTick = true;
+	LocomotionTick.bStartWithTickEnabled = true;
+	LocomotionTick.RegisterTickFunction(InWorld.PersistentLevel);
+}
+
+void UEnemyLocomotionSubsystem::Deinitialize()
+{
+	if (LocomotionTick.IsTickFunctionRegistered())
+	{
+		LocomotionTick.UnRegisterTickFunction();
+	}
+	LocomotionTick.Subsystem = nullptr;
+
+	ResetBatch();
+
+	Super::Deinitialize();
+}
+
+bool UEnemyLocomotionSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UEnemyLocomotionSubsystem::RegisterMover(AEnemyBase* Enemy)
+{
+	if (!Enemy) return;
+
+	// The enemy submits in its own tick, and its movement component consumes the input we add
+	LocomotionTick.AddPrerequisite(Enemy, Enemy->PrimaryActorTick);
+	if (UCharacterMovementComponent* Movement = Enemy->GetCharacterMovement())
+	{
+		Movement->PrimaryComponentTick.AddPrerequisite(this, LocomotionTick);
+	}
+}
+
+void UEnemyLocomotionSubsystem::UnregisterMover(AEnemyBase* Enemy)
+{
+	if (!Enemy) return;
+
+	LocomotionTick.RemovePrerequisite(Enemy, Enemy->PrimaryActorTick);
+	if (UCharacterMovementComponent* Movement = Enemy->GetCharacterMovement())
+	{
+		Movement->PrimaryComponentTick.RemovePrerequisite(this, LocomotionTick);
+	}
+}
+
+void UEnemyLocomotionSubsystem::SubmitRequest(const FEnemyLocomotionRequest& Request)
+{
+	if (!Request.Enemy) return;
+
+	uint8 RequestFlags = 0;
+	if (Request.bRotate) RequestFlags |= EnemyLocomotion::Rotate;
+	if (Request.bMove) RequestFlags |= EnemyLocomotion::Move;
+
+	// Nothing to do: don't even gather the transform
+	if (RequestFlags == 0) return;
+
+	Enemies.Add(Request.Enemy);
+	Archetypes.Add(Request.Archetype);
+	DeltaTimes.Add(Request.DeltaTime);
+	Locations.Add(Request.Enemy->GetActorLocation());
+	Rotations.Add(Request.Enemy->GetActorRotation());
+	TargetLocations.Add(Request.TargetLocation);
+	RotationSpeeds.Add(Request.RotationSpeed);
+	Flags.Add(RequestFlags);
+	Ranges.Add(FVector2f(Request.MinRange, Request.MaxRange));
+	InputScales.Add(Request.MoveScale);
+	StrafeScales.Add(Request.StrafeScale);
+	SteerDirections.Add(Request.SteerDirection);
+}
+
+void UEnemyLocomotionSubsystem::ProcessBatch()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_EnemyLocomotionBatch);
+
+	if (Enemies.Num() == 0) return;
+
+	ComputeBatch();
+	WriteBack();
+	ResetBatch();
+}
+
+void UEnemyLocomotionSubsystem::ResetBatch()
+{
+	Enemies.Reset();
+	Archetypes.Reset();
+	DeltaTimes.Reset();
+	Locations.Reset();
+	Rotations.Reset();
+	TargetLocations.Reset();
+	RotationSpeeds.Reset();
+	Flags.Reset();
+	Ranges.Reset();
+	InputScales.Reset();
+	StrafeScales.Reset();
+	SteerDirections.Reset();
+
+	NewRotations.Reset();
+	MoveDirections.Reset();
+	MoveScales.Reset();
+}
+
+void UEnemyLocomotionSubsystem::ComputeBatch()
+{
+	const int32 Num = Enemies.Num();
+	NewRotations.SetNumUninitialized(Num);
+	MoveDirections.SetNumUninitialized(Num);
+	MoveScales.SetNumUninitialized(Num);
+
+	// Pure math over the arrays: no actor access in this loop
+	for (int32 i = 0; i < Num; i++)
+	{
+		const FVector Location = Locations[i];
+		const FVector TargetLocation = TargetLocations[i];
+		const EEnemyLocomotionArchetype Archetype = Archetypes[i];
+
+		// 1. Rotation
+		FRotator NewRotation = Rotations[i];
+		if (Flags[i] & EnemyLocomotion::Rotate)
+		{
+			bool bHasDesired = true;
+			FRotator Desired;
+
+			switch (Archetype)
+			{
+			case EEnemyLocomotionArchetype::Bot:
+			{
+				// Planar tank turn, towards the flow field when it routes us around walls
+				FVector Direction = SteerDirections[i].IsNearlyZero() ? TargetLocation - Location : SteerDirections[i];
+				Direction.Z = 0.0f;
+				bHasDesired = !Direction.IsNearlyZero();
+				Desired = Direction.Rotation();
+				break;
+			}
+			case EEnemyLocomotionArchetype::Pawn:
+				// Look at target but lock pitch/roll (grounded)
+				Desired = UKismetMathLibrary::FindLookAtRotation(Location, TargetLocation);
+				Desired.Pitch = 0.0f;
+				Desired.Roll = 0.0f;
+				break;
+			default:
+				Desired = UKismetMathLibrary::FindLookAtRotation(Location, TargetLocation);
+				break;
+			}
+
+			if (bHasDesired)
+			{
+				NewRotation = FMath::RInterpTo(NewRotation, Desired, DeltaTimes[i], RotationSpeeds[i]);
+			}
+		}
+		NewRotations[i] = NewRotation;
+
+		// 2. Movement intent (evaluated with the new facing, as the inline code did after SetActorRotation)
+		FVector MoveDirection = FVector::ZeroVector;
+		float MoveScale = 0.0f;
+		if (Flags[i] & EnemyLocomotion::Move)
+		{
+			const FVector Forward = NewRotation.Vector();
+			const float Dist = FVector::Dist(Location, TargetLocation);
+			const float MinRange = Ranges[i].X;
+			const float MaxRange = Ranges[i].Y;
+
+			switch (Archetype)
+			{
+			case EEnemyLocomotionArchetype::Bot:
+				if (Dist > MaxRange)
+				{
+					// Chase, only when roughly facing the target (or the flow field) (+/- 45 degrees)
+					const FVector ChaseDirection = SteerDirections[i].IsNearlyZero() ? (TargetLocation - Location).GetSafeNormal() : SteerDirections[i].GetSafeNormal();
+					if (FVector::DotProduct(Forward, ChaseDirection) > 0.7f)
+					{
+						MoveDirection = Forward;
+						MoveScale = 1.0f;
+					}
+				}
+				else if (Dist < MinRange)
+				{
+					// Too close: back up linearly
+					MoveDirection = Forward;
+					MoveScale = -1.0f;
+				}
+				break;
+
+			case EEnemyLocomotionArchetype::Pawn:
+				if (!SteerDirections[i].IsNearlyZero())
+				{
+					// Approach around the walls along the flow field, at full speed
+					MoveDirection = SteerDirections[i].GetSafeNormal2D();
+					MoveScale = 1.0f;
+				}
+				// Same threshold as the AIController's switch to manual combat movement
+				else if (Dist <= MaxRange * 1.5f)
+				{
+					FVector ToTarget = TargetLocation - Location;
+					ToTarget.Z = 0.0f;
+					if (ToTarget.IsNearlyZero())
+					{
+						ToTarget = Forward;
+						ToTarget.Z = 0.0f;
+					}
+					ToTarget.Normalize();
+
+					// Range management
+					if (Dist > MaxRange)
+					{
+						MoveDirection += ToTarget;
+					}
+					else if (Dist < MinRange)
+					{
+						MoveDirection -= ToTarget;
+					}
+
+					// Strafing
+					if (StrafeScales[i] != 0.0f)
+					{
+						FVector RightVector = FVector::CrossProduct(ToTarget, FVector::UpVector);
+						RightVector.Z = 0.0f;
+						if (!RightVector.IsNearlyZero())
+						{
+							RightVector.Normalize();
+							MoveDirection += RightVector * StrafeScales[i];
+						}
+					}
+
+					if (!MoveDirection.IsNearlyZero())
+					{
+						MoveDirection.Normalize();
+						MoveScale = InputScales[i];
+					}
+				}
+				break;
+
+			case EEnemyLocomotionArchetype::Fly:
+				MoveDirection = SteerDirections[i].GetSafeNormal();
+				MoveScale = InputScales[i];
+				break;
+
+			default:
+				break;
+			}
+		}
+		MoveDirections[i] = MoveDirection;
+		MoveScales[i] = MoveScale;
+	}
+}
+
+void UEnemyLocomotionSubsystem::WriteBack()
+{
+	for (int32 i = 0; i < Enemies.Num(); i++)
+	{
+		// Killed or destroyed since it submitted
+		AEnemyBase* Enemy = Enemies[i].Get();
+		if (!Enemy || !Enemy->IsAlive()) continue;
+
+		if (Flags[i] & EnemyLocomotion::Rotate)
+		{
+			Enemy->SetActorRotation(NewRotations[i]);
+		}
+
+		if (MoveScales[i] != 0.0f && !MoveDirections[i].IsNearlyZero())
+		{
+			Enemy->AddMovementInput(MoveDirections[i], MoveScales[i]);
+
+#if ENABLE_DRAW_DEBUG
+			// Combat move direction (rq.Debug.Strafe): magenta while strafing, white for pure range keeping
+			if (Archetypes[i] == EEnemyLocomotionArchetype::Pawn)
+			{
+				UEnemyDebugDrawSubsystem::DrawLine(this, EEnemyDebugCategory::Strafe, Locations[i], Locations[i] + MoveDirections[i] * 150.0f, StrafeScales[i] != 0.0f ? FColor::Magenta : FColor::White, 2.0f);
+			}
+#endif
+		}
+	}
+}
@@ -0,0 +1,108 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/EnemyPerceptionSubsystem.h"
+#include "Components/EnemyPerceptionComponent.h"
+#include "Engine/World.h"
+
+void UEnemyPerceptionSubsystem::Deinitialize()
+{
+	Listeners.Empty();
+	PendingNoises.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UEnemyPerceptionSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UEnemyPerceptionSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyPerceptionSubsystem, STATGROUP_Tickables);
+}
+
+void UEnemyPerceptionSubsystem::RegisterListener(UEnemyPerceptionComponent* Listener)
+{
+	if (!Listener) return;
+	if (Listeners.ContainsByPredicate([Listener](const FListenerEntry& Entry) { return Entry.Listener == Listener; })) return;
+
+	FListenerEntry& Entry = Listeners.AddDefaulted_GetRef();
+	Entry.Listener = Listener;
+	Entry.LastUpdateTime = GetWorld()->GetTimeSeconds();
+
+	Listener->UpdatePerception();
+}
+
+void UEnemyPerceptionSubsystem::UnregisterListener(UEnemyPerceptionComponent* Listener)
+{
+	const int32 Index = Listeners.IndexOfByPredicate([Listener](const FListenerEntry& Entry) { return Entry.Listener == Listener; });
+	if (Index != INDEX_NONE)
+	{
+		Listeners.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	}
+}
+
+void UEnemyPerceptionSubsystem::ReportNoise(AActor* Source, const FVector& Location, float Loudness)
+{
+	if (!Source || Loudness <= 0.0f) return;
+
+	FNoiseEvent& Noise = PendingNoises.AddDefaulted_GetRef();
+	Noise.Source = Source;
+	Noise.Location = Location;
+	Noise.Loudness = Loudness;
+}
+
+void UEnemyPerceptionSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Destroyed without unregistering
+	Listeners.RemoveAllSwap([](const FListenerEntry& Entry) { return !Entry.Listener.IsValid(); }, EAllowShrinking::No);
+
+	DeliverNoises();
+	UpdateListeners(GetWorld()->GetTimeSeconds());
+}
+
+void UEnemyPerceptionSubsystem::DeliverNoises()
+{
+	if (PendingNoises.Num() == 0) return;
+
+	for (const FNoiseEvent& Noise : PendingNoises)
+	{
+		AActor* Source = Noise.Source.Get();
+		if (!Source) continue;
+
+		for (const FListenerEntry& Entry : Listeners)
+		{
+			UEnemyPerceptionComponent* Listener = Entry.Listener.Get();
+			const AActor* Owner = Listener->GetOwner();
+			const float Range = Listener->HearingRange * Noise.Loudness;
+			if (Owner && FVector::DistSquared(Owner->GetActorLocation(), Noise.Location) <= FMath::Square(Range))
+			{
+				Listener->ReportStimulus(Source, Noise.Location, EEnemyStimulusType::Hearing);
+			}
+		}
+	}
+
+	PendingNoises.Reset();
+}
+
+void UEnemyPerceptionSubsystem::UpdateListeners(double Now)
+{
+	const int32 NumListeners = Listeners.Num();
+	if (NumListeners == 0) return;
+
+	int32 NumUpdates = 0;
+	for (int32 Visited = 0; Visited < NumListeners && NumUpdates < MaxUpdatesPerFrame; Visited++)
+	{
+		Cursor = (Cursor + 1) % NumListeners;
+
+		FListenerEntry& Entry = Listeners[Cursor];
+		if (Now - Entry.LastUpdateTime < UpdateInterval) continue;
+
+		Entry.LastUpdateTime = Now;
+		Entry.Listener->UpdatePerception();
+		NumUpdates++;
+	}
+}
@@ -0,0 +1,134 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/EnemyPoolSubsystem.h"
+#include "Enemy/EnemyBase.h"
+#include "Engine/World.h"
+
+void UEnemyPoolSubsystem::Deinitialize()
+{
+	LogPoolStats();
+
+	// Pooled actors are owned by the world and destroyed with it
+	Pools.Empty();
+
+	Super::Deinitialize();
+}
+
+void UEnemyPoolSubsystem::PrewarmPool(TSubclassOf<AEnemyBase> EnemyClass, int32 Count)
+{
+	if (!EnemyClass) return;
+
+	FEnemyPool& Pool = Pools.FindOrAdd(EnemyClass);
+
+	while (Pool.Stats.PoolSize < Count)
+	{
+		AEnemyBase* Enemy = SpawnPooledEnemy(EnemyClass);
+		if (!Enemy)
+		{
+			break;
+		}
+
+		Pool.FreeEnemies.Add(Enemy);
+		Pool.Stats.PoolSize++;
+	}
+}
+
+AEnemyBase* UEnemyPoolSubsystem::AcquireEnemy(TSubclassOf<AEnemyBase> EnemyClass, const FVector& Location, const FRotator& Rotation)
+{
+	if (!EnemyClass) return nullptr;
+
+	FEnemyPool& Pool = Pools.FindOrAdd(EnemyClass);
+
+	AEnemyBase* Enemy = nullptr;
+	while (!Enemy && Pool.FreeEnemies.Num() > 0)
+	{
+		// Skip entries that were destroyed behind our back (e.g. level streaming)
+		AEnemyBase* Candidate = Pool.FreeEnemies.Pop(EAllowShrinking::No);
+		if (IsValid(Candidate))
+		{
+			Enemy = Candidate;
+		}
+		else
+		{
+			Pool.Stats.PoolSize--;
+		}
+	}
+
+	if (!Enemy)
+	{
+		// Pool ran dry (or was never pre-warmed): grow it
+		Pool.Stats.Misses++;
+
+		Enemy = SpawnPooledEnemy(EnemyClass);
+		if (!Enemy)
+		{
+			return nullptr;
+		}
+		Pool.Stats.PoolSize++;
+	}
+
+	Pool.Stats.ActiveCount++;
+	Pool.Stats.HighWaterMark = FMath::Max(Pool.Stats.HighWaterMark, Pool.Stats.ActiveCount);
+
+	Enemy->ResetForReuse(Location, Rotation);
+
+	return Enemy;
+}
+
+void UEnemyPoolSubsystem::ReleaseEnemy(AEnemyBase* Enemy)
+{
+	if (!IsValid(Enemy)) return;
+
+	FEnemyPool* Pool = Enemy->IsPooled() ? Pools.Find(Enemy->GetClass()) : nullptr;
+	if (!Pool)
+	{
+		// Not one of ours (e.g. placed in the level or spawned directly)
+		Enemy->Destroy();
+		return;
+	}
+
+	if (Pool->FreeEnemies.Contains(Enemy))
+	{
+		// Already back in the pool
+		return;
+	}
+
+	Enemy->DeactivatePooledEnemy();
+
+	Pool->FreeEnemies.Add(Enemy);
+	Pool->Stats.ActiveCount = FMath::Max(0, Pool->Stats.ActiveCount - 1);
+}
+
+FEnemyPoolStats UEnemyPoolSubsystem::GetPoolStats(TSubclassOf<AEnemyBase> EnemyClass) const
+{
+	const FEnemyPool* Pool = Pools.Find(EnemyClass);
+	return Pool ? Pool->Stats : FEnemyPoolStats();
+}
+
+void UEnemyPoolSubsystem::LogPoolStats() const
+{
+	for (const TPair<TObjectPtr<UClass>, FEnemyPool>& Pair : Pools)
+	{
+		const FEnemyPoolStats& Stats = Pair.Value.Stats;
+		UE_LOG(LogTemp, Log, TEXT("UEnemyPoolSubsystem:: %s PoolSize: %d, Active: %d, HighWaterMark: %d, Misses: %d"),
+			*GetNameSafe(Pair.Key), Stats.PoolSize, Stats.ActiveCount, Stats.HighWaterMark, Stats.Misses);
+	}
+}
+
+AEnemyBase* UEnemyPoolSubsystem::SpawnPooledEnemy(UClass* EnemyClass)
+{
+	UWorld* World = GetWorld();
+	if (!World) return nullptr;
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	AEnemyBase* Enemy = World->SpawnActor<AEnemyBase>(EnemyClass, FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
+	if (Enemy)
+	{
+		Enemy->MarkAsPooled();
+		Enemy->DeactivatePooledEnemy();
+	}
+
+	return Enemy;
+}
@@ -0,0 +1,202 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/EnemySignificanceSubsystem.h"
+#include "Subsystems/TargetingSubsystem.h"
+#include "Enemy/EnemyBase.h"
+#include "Enemy/CombatZone.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/Controller.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+
+UEnemySignificanceSubsystem::UEnemySignificanceSubsystem()
+{
+	// High stays at full rate (struct defaults)
+	MediumTier.ActorTickInterval = 0.05f;
+	MediumTier.MovementTickInterval = 0.05f;
+	MediumTier.AnimUpdateRate = 2;
+	MediumTier.ControllerTickInterval = 0.1f;
+
+	LowTier.ActorTickInterval = 0.2f;
+	LowTier.MovementTickInterval = 0.2f;
+	LowTier.AnimUpdateRate = 4;
+	LowTier.ControllerTickInterval = 0.5f;
+}
+
+void UEnemySignificanceSubsystem::Deinitialize()
+{
+	Entries.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UEnemySignificanceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UEnemySignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemySignificanceSubsystem, STATGROUP_Tickables);
+}
+
+void UEnemySignificanceSubsystem::RegisterEnemy(AEnemyBase* Enemy, float DetectRange)
+{
+	if (!Enemy) return;
+
+	FSignificanceEntry* Entry = Entries.FindByPredicate([Enemy](const FSignificanceEntry& It) { return It.Enemy == Enemy; });
+	if (!Entry)
+	{
+		Entry = &Entries.AddDefaulted_GetRef();
+		Entry->Enemy = Enemy;
+	}
+	Entry->DetectRange = DetectRange;
+
+	// Score right away so enemies of sleeping zones never run a full-rate frame, and always push the tier settings:
+	// UpdateEntry only applies tier changes, so a High-tier spawn would otherwise never get its LOD frame-skip setup
+	Entry->Tier = EvaluateTier(Enemy, DetectRange);
+	ApplyTier(Enemy, Entry->Tier);
+}
+
+void UEnemySignificanceSubsystem::UnregisterEnemy(AEnemyBase* Enemy)
+{
+	const int32 Index = Entries.IndexOfByPredicate([Enemy](const FSignificanceEntry& It) { return It.Enemy == Enemy; });
+	if (Index == INDEX_NONE) return;
+
+	if (Entries[Index].Tier != EEnemySignificanceTier::High)
+	{
+		ApplyTier(Enemy, EEnemySignificanceTier::High);
+	}
+
+	Entries.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+void UEnemySignificanceSubsystem::RefreshZone(const ACombatZone* Zone)
+{
+	for (FSignificanceEntry& Entry : Entries)
+	{
+		const AEnemyBase* Enemy = Entry.Enemy.Get();
+		if (Enemy && Enemy->OwningZone == Zone)
+		{
+			UpdateEntry(Entry);
+		}
+	}
+}
+
+EEnemySignificanceTier UEnemySignificanceSubsystem::GetTier(const AEnemyBase* Enemy) const
+{
+	const FSignificanceEntry* Entry = Entries.FindByPredicate([Enemy](const FSignificanceEntry& It) { return It.Enemy == Enemy; });
+	return Entry ? Entry->Tier : EEnemySignificanceTier::High;
+}
+
+void UEnemySignificanceSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Drop enemies destroyed without unregistering
+	Entries.RemoveAllSwap([](const FSignificanceEntry& Entry) { return !Entry.Enemy.IsValid(); }, EAllowShrinking::No);
+
+	const int32 Num = Entries.Num();
+	if (Num == 0) return;
+
+	// Re-score a slice of the enemies every frame
+	const int32 NumEvaluations = FMath::Min(Num, MaxEvaluationsPerFrame);
+	for (int32 i = 0; i < NumEvaluations; i++)
+	{
+		NextEntryIndex = (NextEntryIndex + 1) % Num;
+		UpdateEntry(Entries[NextEntryIndex]);
+	}
+}
+
+void UEnemySignificanceSubsystem::UpdateEntry(FSignificanceEntry& Entry)
+{
+	AEnemyBase* Enemy = Entry.Enemy.Get();
+	if (!Enemy) return;
+
+	const EEnemySignificanceTier NewTier = EvaluateTier(Enemy, Entry.DetectRange);
+	if (NewTier != Entry.Tier)
+	{
+		Entry.Tier = NewTier;
+		ApplyTier(Enemy, NewTier);
+	}
+}
+
+EEnemySignificanceTier UEnemySignificanceSubsystem::EvaluateTier(const AEnemyBase* Enemy, float DetectRange) const
+{
+	// Enemies waiting in a zone the player hasn't entered yet sleep
+	if (Enemy->OwningZone && !Enemy->OwningZone->IsZoneActive())
+	{
+		return EEnemySignificanceTier::Dormant;
+	}
+
+	const UTargetingSubsystem* Targeting = GetWorld()->GetSubsystem<UTargetingSubsystem>();
+	const AActor* Target = Targeting ? Targeting->FindNearestTarget(Enemy->GetActorLocation(), 0.0f) : nullptr;
+	if (!Target)
+	{
+		return EEnemySignificanceTier::Low;
+	}
+
+	const float Dist = FVector::Dist(Enemy->GetActorLocation(), Target->GetActorLocation());
+	const bool bOnScreen = Enemy->WasRecentlyRendered(RecentlyRenderedTolerance);
+
+	if (Dist <= DetectRange)
+	{
+		return (bOnScreen || Dist <= DetectRange * CloseRangeScale) ? EEnemySignificanceTier::High : EEnemySignificanceTier::Medium;
+	}
+
+	if (Dist <= DetectRange * MediumRangeScale && bOnScreen)
+	{
+		return EEnemySignificanceTier::Medium;
+	}
+
+	return EEnemySignificanceTier::Low;
+}
+
+void UEnemySignificanceSubsystem::ApplyTier(AEnemyBase* Enemy, EEnemySignificanceTier Tier) const
+{
+	const bool bTickEnabled = (Tier != EEnemySignificanceTier::Dormant);
+	const FEnemySignificanceTierSettings& Settings = GetTierSettings(Tier);
+
+	Enemy->SetActorTickEnabled(bTickEnabled);
+	Enemy->SetActorTickInterval(Settings.ActorTickInterval);
+
+	if (UCharacterMovementComponent* Movement = Enemy->GetCharacterMovement())
+	{
+		Movement->SetComponentTickEnabled(bTickEnabled);
+		Movement->SetComponentTickInterval(Settings.MovementTickInterval);
+	}
+
+	if (USkeletalMeshComponent* Mesh = Enemy->GetMesh())
+	{
+		Mesh->SetComponentTickEnabled(bTickEnabled);
+
+		// Same frame skip on every LOD while on screen. Off screen the pose is not evaluated at all
+		// (OnlyTickMontagesWhenNotRendered, see AEnemyBase), but montages advance every frame so notifies fire on time.
+		if (FAnimUpdateRateParameters* UpdateRateParams = Mesh->AnimUpdateRateParams)
+		{
+			UpdateRateParams->bShouldUseLodMap = true;
+			UpdateRateParams->BaseNonRenderedUpdateRate = 1;
+			for (int32 LOD = 0; LOD < FMath::Max(1, Mesh->GetNumLODs()); LOD++)
+			{
+				UpdateRateParams->LODToFrameSkipMap.Add(LOD, FMath::Max(1, Settings.AnimUpdateRate) - 1);
+			}
+		}
+	}
+
+	if (AController* Controller = Enemy->GetController())
+	{
+		Controller->SetActorTickEnabled(bTickEnabled);
+		Controller->SetActorTickInterval(Settings.ControllerTickInterval);
+	}
+}
+
+const FEnemySignificanceTierSettings& UEnemySignificanceSubsystem::GetTierSettings(EEnemySignificanceTier Tier) const
+{
+	switch (Tier)
+	{
+	case EEnemySignificanceTier::Medium:	return MediumTier;
+	case EEnemySignificanceTier::Low:		return LowTier;
+	case EEnemySignificanceTier::Dormant:	return LowTier; // Ticking is disabled anyway; slowest rates on wake-up
+	default:								return HighTier;
+	}
+}
@@ -0,0 +1,119 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/EnemySpawnSchedulerSubsystem.h"
+#include "Subsystems/EnemyPoolSubsystem.h"
+#include "Enemy/EnemyBase.h"
+#include "Enemy/EnemySpawnPoint.h"
+#include "Enemy/CombatZone.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+#include "Algo/BinarySearch.h"
+
+void UEnemySpawnSchedulerSubsystem::Deinitialize()
+{
+	PendingSpawns.Empty();
+	PendingPrewarms.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UEnemySpawnSchedulerSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UEnemySpawnSchedulerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemySpawnSchedulerSubsystem, STATGROUP_Tickables);
+}
+
+void UEnemySpawnSchedulerSubsystem::QueuePrewarm(TSubclassOf<AEnemyBase> EnemyClass, int32 Count)
+{
+	if (!EnemyClass || Count <= 0) return;
+
+	if (FPrewarmRequest* Existing = PendingPrewarms.FindByPredicate([EnemyClass](const FPrewarmRequest& It) { return It.EnemyClass == EnemyClass; }))
+	{
+		Existing->Remaining += Count;
+		return;
+	}
+
+	PendingPrewarms.Add({ EnemyClass, Count });
+}
+
+void UEnemySpawnSchedulerSubsystem::QueueSpawn(AEnemySpawnPoint* Point, ACombatZone* Zone, float Delay)
+{
+	if (!Point) return;
+
+	FSpawnRequest Request;
+	Request.Point = Point;
+	Request.Zone = Zone;
+	Request.ReadyTime = GetWorld()->GetTimeSeconds() + FMath::Max(0.0f, Delay);
+
+	// Keep the queue sorted; requests with the same time stay in call order
+	const int32 Index = Algo::UpperBoundBy(PendingSpawns, Request.ReadyTime, &FSpawnRequest::ReadyTime);
+	PendingSpawns.Insert(Request, Index);
+}
+
+void UEnemySpawnSchedulerSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (PendingSpawns.Num() == 0 && PendingPrewarms.Num() == 0) return;
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	const double StartTime = FPlatformTime::Seconds();
+	const double BudgetSeconds = FrameBudgetMs / 1000.0;
+
+	int32 NumProcessed = 0;
+	auto HasBudget = [&]()
+	{
+		return NumProcessed == 0 || (FPlatformTime::Seconds() - StartTime) < BudgetSeconds;
+	};
+
+	// Due spawns first: the player is waiting for them
+	int32 NumConsumed = 0;
+	while (NumConsumed < PendingSpawns.Num() && PendingSpawns[NumConsumed].ReadyTime <= Now && HasBudget())
+	{
+		ProcessSpawn(PendingSpawns[NumConsumed]);
+		NumConsumed++;
+		NumProcessed++;
+	}
+	PendingSpawns.RemoveAt(0, NumConsumed, EAllowShrinking::No);
+
+	// Then pre-warming with whatever is left
+	while (PendingPrewarms.Num() > 0 && HasBudget())
+	{
+		ProcessPrewarm();
+		NumProcessed++;
+	}
+}
+
+void UEnemySpawnSchedulerSubsystem::ProcessSpawn(const FSpawnRequest& Request)
+{
+	AEnemySpawnPoint* Point = Request.Point.Get();
+	if (!Point) return;
+
+	if (AEnemyBase* Enemy = Point->SpawnEnemy())
+	{
+		Enemy->OwningZone = Request.Zone.Get();
+	}
+}
+
+void UEnemySpawnSchedulerSubsystem::ProcessPrewarm()
+{
+	FPrewarmRequest& Request = PendingPrewarms[0];
+
+	UEnemyPoolSubsystem* Pool = GetWorld()->GetSubsystem<UEnemyPoolSubsystem>();
+	const int32 PoolSize = Pool ? Pool->GetPoolStats(Request.EnemyClass).PoolSize : 0;
+	if (Pool)
+	{
+		Pool->PrewarmPool(Request.EnemyClass, PoolSize + 1);
+	}
+
+	// Drop the request once done, or if the class can't be spawned at all
+	const bool bGrew = Pool && Pool->GetPoolStats(Request.EnemyClass).PoolSize > PoolSize;
+	if (--Request.Remaining <= 0 || !bGrew)
+	{
+		PendingPrewarms.RemoveAt(0, 1, EAllowShrinking::No);
+	}
+}
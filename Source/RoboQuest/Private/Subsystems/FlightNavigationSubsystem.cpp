@@ -0,0 +1,318 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/FlightNavigationSubsystem.h"
+#include "Subsystems/OccupancyGridSubsystem.h"
+#include "World/OccupancyGridVolume.h"
+#include "Engine/World.h"
+#include "Algo/Reverse.h"
+
+namespace
+{
+	// Start brick (bits 32+), goal brick (bits 8-31) and clearance (bits 0-7)
+	uint64 MakePathCacheKey(const FOccupancyGridData& Grid, const FVector& Start, const FVector& Goal, uint8 MinClearance)
+	{
+		auto GetBrickIndex = [&Grid](const FVector& Location) -> uint64
+		{
+			const FIntVector Brick = Grid.WorldToVoxel(Location) / FOccupancyGridData::BrickSize;
+			return Brick.X + Brick.Y * Grid.NumBricks.X + Brick.Z * Grid.NumBricks.X * Grid.NumBricks.Y;
+		};
+
+		return (GetBrickIndex(Start) << 32) | (GetBrickIndex(Goal) << 8) | MinClearance;
+	}
+
+	struct FNeighborOffset
+	{
+		FIntVector Offset;
+		float Cost;
+	};
+
+	// The 26 neighbors of a voxel, with their distance in voxels
+	const TArray<FNeighborOffset>& GetNeighborOffsets()
+	{
+		static const TArray<FNeighborOffset> Offsets = []()
+		{
+			TArray<FNeighborOffset> Result;
+			for (int32 Z = -1; Z <= 1; Z++)
+			{
+				for (int32 Y = -1; Y <= 1; Y++)
+				{
+					for (int32 X = -1; X <= 1; X++)
+					{
+						if (X != 0 || Y != 0 || Z != 0)
+						{
+							Result.Add({ FIntVector(X, Y, Z), FMath::Sqrt((float)(X * X + Y * Y + Z * Z)) });
+						}
+					}
+				}
+			}
+			return Result;
+		}();
+		return Offsets;
+	}
+}
+
+void UFlightNavigationSubsystem::Deinitialize()
+{
+	// Running tasks hold their own reference to the grid, their results are simply dropped
+	PendingQueries.Empty();
+	PathCache.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UFlightNavigationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UFlightNavigationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFlightNavigationSubsystem, STATGROUP_Tickables);
+}
+
+void UFlightNavigationSubsystem::ClearPathCache()
+{
+	PathCache.Empty();
+}
+
+bool UFlightNavigationSubsystem::RequestPath(const FVector& Start, const FVector& Goal, float AgentRadius, FFlightPathCallback OnComplete)
+{
+	const UOccupancyGridSubsystem* Grids = GetWorld()->GetSubsystem<UOccupancyGridSubsystem>();
+	const AOccupancyGridVolume* Volume = Grids ? Grids->FindVolume(Start) : nullptr;
+	if (!Volume || !Volume->ContainsLocation(Goal)) return false;
+
+	TSharedPtr<const FOccupancyGridData, ESPMode::ThreadSafe> Grid = Volume->GetSharedGridData();
+	if (!Grid.IsValid()) return false;
+
+	const uint8 MinClearance = Grid->QuantizeDistance(AgentRadius);
+
+	// Straight line: no search needed
+	if (IsSegmentFlyable(*Grid, Start, Goal, MinClearance))
+	{
+		OnComplete({ Goal });
+		return true;
+	}
+
+	// Somebody already flew between these two bricks: reuse the path if we can join and leave it in a straight line
+	const uint64 CacheKey = MakePathCacheKey(*Grid, Start, Goal, MinClearance);
+	if (const TMap<uint64, TArray<FVector>>* Cache = PathCache.Find(Volume))
+	{
+		const TArray<FVector>* Cached = Cache->Find(CacheKey);
+		if (Cached && IsSegmentFlyable(*Grid, Start, (*Cached)[0], MinClearance) && IsSegmentFlyable(*Grid, Cached->Last(), Goal, MinClearance))
+		{
+			TArray<FVector> Path = *Cached;
+			Path.Add(Goal);
+			OnComplete(Path);
+			return true;
+		}
+	}
+
+	FPathQuery& Query = PendingQueries.AddDefaulted_GetRef();
+	Query.OnComplete = MoveTemp(OnComplete);
+	Query.Volume = Volume;
+	Query.CacheKey = CacheKey;
+
+	const int32 NodeBudget = MaxExpandedNodes;
+	Query.Task = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Grid, Start, Goal, MinClearance, NodeBudget]()
+	{
+		return FindPath(*Grid, Start, Goal, MinClearance, NodeBudget);
+	});
+
+	return true;
+}
+
+void UFlightNavigationSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (PendingQueries.Num() == 0) return;
+
+	// Collect first: callbacks may request new paths
+	TArray<FPathQuery, TInlineAllocator<16>> Completed;
+	for (int32 i = PendingQueries.Num() - 1; i >= 0; i--)
+	{
+		if (PendingQueries[i].Task.IsCompleted())
+		{
+			Completed.Add(MoveTemp(PendingQueries[i]));
+			PendingQueries.RemoveAtSwap(i, 1, EAllowShrinking::No);
+		}
+	}
+
+	for (FPathQuery& Query : Completed)
+	{
+		const TArray<FVector>& Path = Query.Task.GetResult();
+
+		// Waypoints between the two ends, for the next agent flying between the same bricks
+		if (Path.Num() > 1 && Query.Volume.ResolveObjectPtr())
+		{
+			TMap<uint64, TArray<FVector>>& Cache = PathCache.FindOrAdd(Query.Volume);
+			if (Cache.Num() >= MaxCachedPathsPerGrid)
+			{
+				Cache.Reset();
+			}
+			Cache.Add(Query.CacheKey, TArray<FVector>(Path.GetData(), Path.Num() - 1));
+		}
+
+		if (Query.OnComplete)
+		{
+			Query.OnComplete(Path);
+		}
+	}
+}
+
+bool UFlightNavigationSubsystem::IsSegmentFlyable(const FOccupancyGridData& Grid, const FVector& From, const FVector& To, uint8 MinClearance)
+{
+	// March in half-voxel steps
+	const float StepSize = Grid.VoxelSize * 0.5f;
+	const int32 NumSteps = FMath::Max(1, FMath::CeilToInt(FVector::Dist(From, To) / StepSize));
+
+	for (int32 i = 0; i <= NumSteps; i++)
+	{
+		const FIntVector Voxel = Grid.WorldToVoxel(FMath::Lerp(From, To, (float)i / NumSteps));
+		if (!Grid.IsInside(Voxel) || Grid.GetVoxelValue(Voxel) < MinClearance)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool UFlightNavigationSubsystem::FindFlyableVoxel(const FOccupancyGridData& Grid, FIntVector& InOutVoxel, uint8 MinClearance)
+{
+	if (Grid.IsInside(InOutVoxel) && Grid.GetVoxelValue(InOutVoxel) >= MinClearance)
+	{
+		return true;
+	}
+
+	// Most open voxel around
+	constexpr int32 SearchRadius = 2;
+	FIntVector Best = InOutVoxel;
+	uint8 BestValue = 0;
+	for (int32 Z = -SearchRadius; Z <= SearchRadius; Z++)
+	{
+		for (int32 Y = -SearchRadius; Y <= SearchRadius; Y++)
+		{
+			for (int32 X = -SearchRadius; X <= SearchRadius; X++)
+			{
+				const FIntVector Voxel = InOutVoxel + FIntVector(X, Y, Z);
+				const uint8 Value = Grid.IsInside(Voxel) ? Grid.GetVoxelValue(Voxel) : 0;
+				if (Value >= MinClearance && Value > BestValue)
+				{
+					Best = Voxel;
+					BestValue = Value;
+				}
+			}
+		}
+	}
+
+	InOutVoxel = Best;
+	return BestValue > 0;
+}
+
+TArray<FVector> UFlightNavigationSubsystem::FindPath(const FOccupancyGridData& Grid, const FVector& Start, const FVector& Goal, uint8 MinClearance, int32 MaxExpandedNodes)
+{
+	TArray<FVector> Path;
+
+	FIntVector StartVoxel = Grid.WorldToVoxel(Start);
+	FIntVector GoalVoxel = Grid.WorldToVoxel(Goal);
+	if (!FindFlyableVoxel(Grid, StartVoxel, MinClearance) || !FindFlyableVoxel(Grid, GoalVoxel, MinClearance))
+	{
+		return Path;
+	}
+
+	const int32 StrideY = Grid.NumVoxels.X;
+	const int32 StrideZ = Grid.NumVoxels.X * Grid.NumVoxels.Y;
+	auto ToIndex = [StrideY, StrideZ](const FIntVector& Voxel) { return Voxel.X + Voxel.Y * StrideY + Voxel.Z * StrideZ; };
+	auto ToVoxel = [StrideY, StrideZ](int32 Index) { return FIntVector(Index % StrideY, (Index % StrideZ) / StrideY, Index / StrideZ); };
+	auto Heuristic = [&GoalVoxel](const FIntVector& Voxel) { return FVector(GoalVoxel - Voxel).Size(); };
+
+	struct FNodeRecord
+	{
+		float G;
+		int32 Parent;
+		bool bClosed;
+	};
+
+	struct FOpenEntry
+	{
+		float F;
+		int32 Index;
+		bool operator<(const FOpenEntry& Other) const { return F < Other.F; }
+	};
+
+	// Sparse bookkeeping: only the voxels the search touches
+	TMap<int32, FNodeRecord> Nodes;
+	TArray<FOpenEntry> Open;
+
+	const int32 StartIndex = ToIndex(StartVoxel);
+	const int32 GoalIndex = ToIndex(GoalVoxel);
+	Nodes.Add(StartIndex, { 0.0f, INDEX_NONE, false });
+	Open.HeapPush({ Heuristic(StartVoxel), StartIndex });
+
+	bool bFound = false;
+	int32 NumExpanded = 0;
+	while (Open.Num() > 0 && NumExpanded < MaxExpandedNodes)
+	{
+		FOpenEntry Current;
+		Open.HeapPop(Current, EAllowShrinking::No);
+
+		FNodeRecord& Record = Nodes[Current.Index];
+		if (Record.bClosed) continue;
+		Record.bClosed = true;
+		NumExpanded++;
+
+		if (Current.Index == GoalIndex)
+		{
+			bFound = true;
+			break;
+		}
+
+		// Copy: adding neighbors may grow the map
+		const float G = Record.G;
+		const FIntVector Voxel = ToVoxel(Current.Index);
+
+		for (const FNeighborOffset& Neighbor : GetNeighborOffsets())
+		{
+			const FIntVector Next = Voxel + Neighbor.Offset;
+			if (!Grid.IsInside(Next) || Grid.GetVoxelValue(Next) < MinClearance) continue;
+
+			const int32 NextIndex = ToIndex(Next);
+			const float NextG = G + Neighbor.Cost;
+
+			const FNodeRecord* NextRecord = Nodes.Find(NextIndex);
+			if (NextRecord && (NextRecord->bClosed || NextRecord->G <= NextG)) continue;
+
+			Nodes.Add(NextIndex, { NextG, Current.Index, false });
+			Open.HeapPush({ NextG + Heuristic(Next), NextIndex });
+		}
+	}
+
+	if (!bFound)
+	{
+		return Path;
+	}
+
+	// Voxel chain from start to goal
+	TArray<FVector> Chain;
+	for (int32 Index = GoalIndex; Index != INDEX_NONE; Index = Nodes[Index].Parent)
+	{
+		Chain.Add(Grid.VoxelToWorld(ToVoxel(Index)));
+	}
+	Algo::Reverse(Chain);
+	Chain[0] = Start;
+	Chain.Last() = Goal;
+
+	// String pulling: only keep the voxels where the straight line breaks
+	FVector Anchor = Start;
+	for (int32 i = 1; i < Chain.Num() - 1; i++)
+	{
+		if (!IsSegmentFlyable(Grid, Anchor, Chain[i + 1], MinClearance))
+		{
+			Path.Add(Chain[i]);
+			Anchor = Chain[i];
+		}
+	}
+	Path.Add(Goal);
+
+	return Path;
+}
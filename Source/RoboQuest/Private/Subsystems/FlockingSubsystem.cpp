@@ -0,0 +1,162 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/FlockingSubsystem.h"
+#include "Enemy/EnemyBase.h"
+#include "Engine/World.h"
+
+void UFlockingSubsystem::Deinitialize()
+{
+	Agents.Empty();
+	SteeringByAgent.Empty();
+	CellHeads.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UFlockingSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UFlockingSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFlockingSubsystem, STATGROUP_Tickables);
+}
+
+void UFlockingSubsystem::RegisterAgent(AEnemyBase* Agent)
+{
+	if (!Agent || Agents.Contains(Agent)) return;
+
+	Agents.Add(Agent);
+}
+
+void UFlockingSubsystem::UnregisterAgent(AEnemyBase* Agent)
+{
+	Agents.RemoveSingleSwap(Agent, EAllowShrinking::No);
+	SteeringByAgent.Remove(Agent);
+}
+
+FVector UFlockingSubsystem::GetSteering(const AEnemyBase* Agent) const
+{
+	const FVector* Result = SteeringByAgent.Find(Agent);
+	return Result ? *Result : FVector::ZeroVector;
+}
+
+FIntVector UFlockingSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt(Location.X / NeighborRadius),
+		FMath::FloorToInt(Location.Y / NeighborRadius),
+		FMath::FloorToInt(Location.Z / NeighborRadius));
+}
+
+void UFlockingSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Drop agents destroyed without unregistering
+	Agents.RemoveAllSwap([](const TWeakObjectPtr<AEnemyBase>& Agent) { return !Agent.IsValid(); }, EAllowShrinking::No);
+
+	SteeringByAgent.Reset();
+	if (Agents.Num() > 0 && NeighborRadius > 0.0f)
+	{
+		UpdateFlock();
+	}
+}
+
+void UFlockingSubsystem::UpdateFlock()
+{
+	// 1. Positions and velocities of the live agents, in contiguous arrays
+	LiveAgents.Reset();
+	Positions.Reset();
+	Velocities.Reset();
+	for (const TWeakObjectPtr<AEnemyBase>& AgentPtr : Agents)
+	{
+		AEnemyBase* Agent = AgentPtr.Get();
+		if (!Agent->IsAlive()) continue;
+
+		LiveAgents.Add(Agent);
+		Positions.Add(Agent->GetActorLocation());
+		Velocities.Add(Agent->GetVelocity());
+	}
+
+	// 2. Rebuild the grid: one linked list of agents per occupied cell
+	const int32 NumLive = LiveAgents.Num();
+	CellHeads.Reset();
+	NextInCell.SetNumUninitialized(NumLive, EAllowShrinking::No);
+	for (int32 i = 0; i < NumLive; i++)
+	{
+		int32& Head = CellHeads.FindOrAdd(GetCell(Positions[i]), INDEX_NONE);
+		NextInCell[i] = Head;
+		Head = i;
+	}
+
+	// 3. Steering from the neighbors found in the 27 cells around each agent
+	const float NeighborRadiusSq = FMath::Square(NeighborRadius);
+	const float SeparationRadiusSq = FMath::Square(SeparationRadius);
+
+	for (int32 i = 0; i < NumLive; i++)
+	{
+		const FVector Position = Positions[i];
+		const FIntVector Cell = GetCell(Position);
+
+		// Keep the MaxNeighbors nearest agents within NeighborRadius, whatever cell they are in
+		const auto FartherFirst = [](const FNeighbor& A, const FNeighbor& B) { return A.DistSq > B.DistSq; };
+		NearestNeighbors.Reset();
+
+		for (int32 X = -1; X <= 1; X++)
+		{
+			for (int32 Y = -1; Y <= 1; Y++)
+			{
+				for (int32 Z = -1; Z <= 1; Z++)
+				{
+					const int32* Head = CellHeads.Find(Cell + FIntVector(X, Y, Z));
+					for (int32 j = Head ? *Head : INDEX_NONE; j != INDEX_NONE; j = NextInCell[j])
+					{
+						if (j == i) continue;
+
+						const float DistSq = FVector::DistSquared(Position, Positions[j]);
+						if (DistSq > NeighborRadiusSq) continue;
+
+						if (NearestNeighbors.Num() < MaxNeighbors)
+						{
+							NearestNeighbors.HeapPush(FNeighbor{ DistSq, j }, FartherFirst);
+						}
+						else if (MaxNeighbors > 0 && DistSq < NearestNeighbors.HeapTop().DistSq)
+						{
+							// Replace the farthest neighbor kept so far
+							NearestNeighbors.HeapPopDiscard(FartherFirst, EAllowShrinking::No);
+							NearestNeighbors.HeapPush(FNeighbor{ DistSq, j }, FartherFirst);
+						}
+					}
+				}
+			}
+		}
+
+		FVector Separation = FVector::ZeroVector;
+		FVector VelocitySum = FVector::ZeroVector;
+		FVector PositionSum = FVector::ZeroVector;
+		const int32 NumNeighbors = NearestNeighbors.Num();
+
+		for (const FNeighbor& Neighbor : NearestNeighbors)
+		{
+			// Push harder the closer the neighbor is (1 at SeparationRadius)
+			if (Neighbor.DistSq < SeparationRadiusSq && Neighbor.DistSq > KINDA_SMALL_NUMBER)
+			{
+				Separation += (Position - Positions[Neighbor.Index]) * (SeparationRadius / Neighbor.DistSq);
+			}
+
+			VelocitySum += Velocities[Neighbor.Index];
+			PositionSum += Positions[Neighbor.Index];
+		}
+
+		if (NumNeighbors == 0) continue;
+
+		// Match the neighbors' heading and drift towards their center
+		const FVector Alignment = (VelocitySum / NumNeighbors - Velocities[i]).GetSafeNormal();
+		const FVector Cohesion = (PositionSum / NumNeighbors - Position).GetSafeNormal();
+
+		const FVector Result = Separation * SeparationWeight + Alignment * AlignmentWeight + Cohesion * CohesionWeight;
+		SteeringByAgent.Add(LiveAgents[i], Result.GetClampedToMaxSize(1.0f));
+	}
+}
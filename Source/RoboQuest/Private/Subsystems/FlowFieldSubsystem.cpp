@@ -0,0 +1,335 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/FlowFieldSubsystem.h"
+#include "NavigationSystem.h"
+#include "Engine/World.h"
+
+namespace
+{
+	// The 8 neighbors of a cell and their step costs. Opposite neighbors are stored in pairs (n and n ^ 1).
+	const FIntPoint FlowNeighbors[8] = {
+		FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1),
+		FIntPoint(1, 1), FIntPoint(-1, -1), FIntPoint(1, -1), FIntPoint(-1, 1)
+	};
+	const float FlowNeighborCosts[8] = { 1.0f, 1.0f, 1.0f, 1.0f, UE_SQRT_2, UE_SQRT_2, UE_SQRT_2, UE_SQRT_2 };
+}
+
+void UFlowFieldSubsystem::Deinitialize()
+{
+	// Running solves hold their own reference to their window, their results are simply dropped
+	Fields.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UFlowFieldSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UFlowFieldSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFlowFieldSubsystem, STATGROUP_Tickables);
+}
+
+FIntPoint UFlowFieldSubsystem::WorldToCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+FVector UFlowFieldSubsystem::CellToWorld(const FIntPoint& Cell, float Z) const
+{
+	return FVector((Cell.X + 0.5f) * CellSize, (Cell.Y + 0.5f) * CellSize, Z);
+}
+
+FVector UFlowFieldSubsystem::GetGoalLocation(const FFlowField& Field)
+{
+	return Field.bFixedGoal ? Field.GoalLocation : Field.Target->GetActorLocation();
+}
+
+bool UFlowFieldSubsystem::NeedsNewWindow(const FFlowWindow* Window, const FIntPoint& Cell, float GoalZ) const
+{
+	return !Window
+		|| Cell.X < Window->Origin.X + RecenterMargin || Cell.Y < Window->Origin.Y + RecenterMargin
+		|| Cell.X >= Window->Origin.X + Window->Size - RecenterMargin || Cell.Y >= Window->Origin.Y + Window->Size - RecenterMargin
+		|| FMath::Abs(GoalZ - Window->AnchorZ) > MaxHeightDifference;
+}
+
+bool UFlowFieldSubsystem::GetFlowDirection(AActor* Target, const FVector& Location, FVector& OutDirection)
+{
+	if (!Target) return false;
+
+	FFlowField* Field = Fields.FindByPredicate([Target](const FFlowField& It) { return !It.bFixedGoal && It.Target == Target; });
+	if (!Field)
+	{
+		Field = &Fields.AddDefaulted_GetRef();
+		Field->Target = Target;
+	}
+
+	return ReadFlowDirection(*Field, Location, OutDirection);
+}
+
+bool UFlowFieldSubsystem::GetFlowDirectionToLocation(const FVector& Goal, const FVector& Location, FVector& OutDirection)
+{
+	const FIntPoint GoalCell = WorldToCell(Goal);
+
+	FFlowField* Field = Fields.FindByPredicate([this, &GoalCell, &Goal](const FFlowField& It)
+	{
+		return It.bFixedGoal && WorldToCell(It.GoalLocation) == GoalCell && FMath::Abs(It.GoalLocation.Z - Goal.Z) <= MaxHeightDifference;
+	});
+
+	if (!Field)
+	{
+		Field = &Fields.AddDefaulted_GetRef();
+		Field->bFixedGoal = true;
+		Field->GoalLocation = Goal;
+
+		// Borrow a window that already covers the goal (usually the one of the target last sensed there): no sampling
+		for (const FFlowField& Other : Fields)
+		{
+			if (&Other != Field && !NeedsNewWindow(Other.Window.Get(), GoalCell, Goal.Z))
+			{
+				Field->Window = Other.Window;
+				break;
+			}
+		}
+	}
+
+	return ReadFlowDirection(*Field, Location, OutDirection);
+}
+
+bool UFlowFieldSubsystem::ReadFlowDirection(FFlowField& Field, const FVector& Location, FVector& OutDirection)
+{
+	Field.LastQueryTime = GetWorld()->GetTimeSeconds();
+
+	const FFlowWindow* Window = Field.Window.Get();
+	if (!Window || Field.Directions.Num() == 0) return false;
+
+	const FIntPoint Cell = WorldToCell(Location);
+	if (!Window->Contains(Cell)) return false;
+
+	const int32 Index = Window->ToIndex(Cell);
+	const uint8 Direction = Field.Directions[Index];
+	if (Direction >= AtGoal) return false;
+
+	// Another floor: the field does not apply
+	if (FMath::Abs(Location.Z - Window->Heights[Index]) > MaxHeightDifference) return false;
+
+	OutDirection = FVector(FlowNeighbors[Direction].X, FlowNeighbors[Direction].Y, 0.0f).GetSafeNormal();
+	return true;
+}
+
+void UFlowFieldSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const float Now = GetWorld()->GetTimeSeconds();
+
+	// Targets gone or nobody chasing them anymore
+	Fields.RemoveAllSwap([this, Now](const FFlowField& Field)
+	{
+		return (!Field.bFixedGoal && !Field.Target.IsValid()) || Now - Field.LastQueryTime > FieldIdleTimeout;
+	}, EAllowShrinking::No);
+
+	int32 Budget = MaxNavQueriesPerFrame;
+	for (FFlowField& Field : Fields)
+	{
+		const FVector TargetLocation = GetGoalLocation(Field);
+		const FIntPoint TargetCell = WorldToCell(TargetLocation);
+
+		// 1. Start sampling a new window when the target nears the edge of the current one (or there is none)
+		const FFlowWindow* Window = Field.Window.Get();
+		const bool bNearEdge = NeedsNewWindow(Window, TargetCell, TargetLocation.Z);
+
+		if (bNearEdge && !Field.PendingWindow.IsValid())
+		{
+			Field.PendingWindow = MakeShared<FFlowWindow, ESPMode::ThreadSafe>();
+			Field.PendingWindow->Origin = TargetCell - FIntPoint(WindowSize / 2, WindowSize / 2);
+			Field.PendingWindow->Size = WindowSize;
+			Field.PendingWindow->AnchorZ = TargetLocation.Z;
+			Field.PendingWindow->Heights.SetNumZeroed(WindowSize * WindowSize);
+			Field.PendingWindow->Flags.SetNumZeroed(WindowSize * WindowSize);
+			Field.SamplePhase = 0;
+			Field.NextSampleIndex = 0;
+		}
+
+		// 2. Incremental sampling, shared budget; a complete window replaces the current one
+		if (Field.PendingWindow.IsValid() && Budget > 0)
+		{
+			Budget -= SampleWindow(Field, Budget);
+		}
+
+		// 3. Pick up a finished solve (dropped if the window changed meanwhile)
+		if (Field.bSolving && Field.SolveTask.IsCompleted())
+		{
+			Field.bSolving = false;
+			if (Field.SolvingWindow == Field.Window)
+			{
+				Field.Directions = Field.SolveTask.GetResult();
+				Field.SolvedGoal = Field.SolvingGoal;
+			}
+			Field.SolvingWindow.Reset();
+		}
+
+		// 4. Re-solve when the target changed cell
+		Window = Field.Window.Get();
+		const bool bNeedsSolve = Window && Window->Contains(TargetCell) && (Field.SolvedGoal != TargetCell || Field.Directions.Num() == 0);
+		if (bNeedsSolve && !Field.bSolving)
+		{
+			Field.bSolving = true;
+			Field.SolvingWindow = Field.Window;
+			Field.SolvingGoal = TargetCell;
+
+			FFlowWindowPtr SolveWindow = Field.Window;
+			Field.SolveTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [SolveWindow, TargetCell]()
+			{
+				return SolveField(*SolveWindow, TargetCell);
+			});
+		}
+	}
+}
+
+int32 UFlowFieldSubsystem::SampleWindow(FFlowField& Field, int32 Budget)
+{
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (!NavSys) return 0;
+
+	FFlowWindow& Window = *Field.PendingWindow;
+	const int32 NumCells = Window.Size * Window.Size;
+	const FVector ProjectionExtent(CellSize * 0.5f, CellSize * 0.5f, VerticalExtent);
+
+	int32 NumQueries = 0;
+	while (NumQueries < Budget && Field.NextSampleIndex < NumCells)
+	{
+		const int32 Index = Field.NextSampleIndex++;
+		const FIntPoint Cell = Window.Origin + FIntPoint(Index % Window.Size, Index / Window.Size);
+
+		if (Field.SamplePhase == 0)
+		{
+			// Is there navmesh in this cell, and at which height?
+			FNavLocation NavLocation;
+			if (NavSys->ProjectPointToNavigation(CellToWorld(Cell, Window.AnchorZ), NavLocation, ProjectionExtent))
+			{
+				Window.Flags[Index] |= Walkable;
+				Window.Heights[Index] = NavLocation.Location.Z;
+			}
+			NumQueries++;
+		}
+		else if (Window.Flags[Index] & Walkable)
+		{
+			// Can we walk straight to the +X / +Y neighbor (no wall, no gap in between)?
+			const FVector From = CellToWorld(Cell, Window.Heights[Index]);
+			FVector HitLocation;
+
+			const FIntPoint Right = Cell + FIntPoint(1, 0);
+			if (Window.Contains(Right) && (Window.Flags[Window.ToIndex(Right)] & Walkable))
+			{
+				if (!UNavigationSystemV1::NavigationRaycast(this, From, CellToWorld(Right, Window.Heights[Window.ToIndex(Right)]), HitLocation))
+				{
+					Window.Flags[Index] |= LinkX;
+				}
+				NumQueries++;
+			}
+
+			const FIntPoint Up = Cell + FIntPoint(0, 1);
+			if (Window.Contains(Up) && (Window.Flags[Window.ToIndex(Up)] & Walkable))
+			{
+				if (!UNavigationSystemV1::NavigationRaycast(this, From, CellToWorld(Up, Window.Heights[Window.ToIndex(Up)]), HitLocation))
+				{
+					Window.Flags[Index] |= LinkY;
+				}
+				NumQueries++;
+			}
+		}
+
+		if (Field.NextSampleIndex == NumCells && Field.SamplePhase == 0)
+		{
+			// Projections done, now the links
+			Field.SamplePhase = 1;
+			Field.NextSampleIndex = 0;
+		}
+	}
+
+	if (Field.SamplePhase == 1 && Field.NextSampleIndex == NumCells)
+	{
+		// Complete: becomes the field's window, the next Tick solves it
+		Field.Window = Field.PendingWindow;
+		Field.PendingWindow.Reset();
+		Field.Directions.Reset();
+	}
+
+	return NumQueries;
+}
+
+TArray<uint8> UFlowFieldSubsystem::SolveField(const FFlowWindow& Window, FIntPoint Goal)
+{
+	const int32 NumCells = Window.Size * Window.Size;
+
+	TArray<uint8> Directions;
+	Directions.Init(NoDirection, NumCells);
+	if (!Window.Contains(Goal) || !(Window.Flags[Window.ToIndex(Goal)] & Walkable))
+	{
+		return Directions;
+	}
+
+	// Orthogonal step between two cells (links are stored on the lower cell)
+	auto IsLinked = [&Window](const FIntPoint& Cell, const FIntPoint& Step)
+	{
+		const FIntPoint Next = Cell + Step;
+		if (!Window.Contains(Next)) return false;
+
+		const FIntPoint& Low = (Step.X < 0 || Step.Y < 0) ? Next : Cell;
+		return (Window.Flags[Window.ToIndex(Low)] & (Step.X != 0 ? LinkX : LinkY)) != 0;
+	};
+
+	// Diagonals need both L-shaped detours, so nobody cuts a corner
+	auto CanStep = [&IsLinked](const FIntPoint& Cell, const FIntPoint& Step)
+	{
+		if (Step.X == 0 || Step.Y == 0) return IsLinked(Cell, Step);
+
+		const FIntPoint StepX(Step.X, 0);
+		const FIntPoint StepY(0, Step.Y);
+		return IsLinked(Cell, StepX) && IsLinked(Cell + StepX, StepY) && IsLinked(Cell, StepY) && IsLinked(Cell + StepY, StepX);
+	};
+
+	struct FOpenEntry
+	{
+		float Cost;
+		int32 Index;
+		bool operator<(const FOpenEntry& Other) const { return Cost < Other.Cost; }
+	};
+
+	TArray<float> Costs;
+	Costs.Init(MAX_flt, NumCells);
+	TArray<FOpenEntry> Open;
+
+	const int32 GoalIndex = Window.ToIndex(Goal);
+	Costs[GoalIndex] = 0.0f;
+	Directions[GoalIndex] = AtGoal;
+	Open.HeapPush({ 0.0f, GoalIndex });
+
+	while (Open.Num() > 0)
+	{
+		FOpenEntry Current;
+		Open.HeapPop(Current, EAllowShrinking::No);
+		if (Current.Cost > Costs[Current.Index]) continue; // Stale entry
+
+		const FIntPoint Cell = Window.Origin + FIntPoint(Current.Index % Window.Size, Current.Index / Window.Size);
+		for (int32 n = 0; n < 8; n++)
+		{
+			if (!CanStep(Cell, FlowNeighbors[n])) continue;
+
+			const int32 NextIndex = Window.ToIndex(Cell + FlowNeighbors[n]);
+			const float NextCost = Current.Cost + FlowNeighborCosts[n];
+			if (NextCost >= Costs[NextIndex]) continue;
+
+			Costs[NextIndex] = NextCost;
+			Open.HeapPush({ NextCost, NextIndex });
+
+			// Walk back the way we came: the opposite neighbor
+			Directions[NextIndex] = (uint8)(n ^ 1);
+		}
+	}
+
+	return Directions;
+}
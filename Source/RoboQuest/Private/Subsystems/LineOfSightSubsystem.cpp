@@ -0,0 +1,166 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/LineOfSightSubsystem.h"
+#include "Engine/World.h"
+
+void ULineOfSightSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	TraceDelegate.BindUObject(this, &ULineOfSightSubsystem::OnTraceCompleted);
+}
+
+void ULineOfSightSubsystem::Deinitialize()
+{
+	TraceDelegate.Unbind();
+
+	Entries.Empty();
+	TraceQueue.Empty();
+	TraceQueueHead = 0;
+	EvictionCursor = 0;
+	InFlightTraces.Empty();
+
+	Super::Deinitialize();
+}
+
+bool ULineOfSightSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId ULineOfSightSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(ULineOfSightSubsystem, STATGROUP_Tickables);
+}
+
+uint64 ULineOfSightSubsystem::MakeKey(const AActor* Viewer, const AActor* Target)
+{
+	return (static_cast<uint64>(Viewer->GetUniqueID()) << 32) | static_cast<uint64>(Target->GetUniqueID());
+}
+
+bool ULineOfSightSubsystem::HasLineOfSight(const AActor* Viewer, const AActor* Target, const FVector& EyeOffset)
+{
+	if (!Viewer || !Target) return false;
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	const uint64 Key = MakeKey(Viewer, Target);
+
+	FLineOfSightEntry* Entry = Entries.Find(Key);
+	if (!Entry)
+	{
+		Entry = &Entries.Add(Key);
+		Entry->Viewer = Viewer;
+		Entry->Target = Target;
+	}
+
+	Entry->EyeOffset = EyeOffset;
+	Entry->LastRequestTime = Now;
+
+	// Stale (or never traced): schedule a refresh, but keep answering with the last known result
+	const bool bStale = Entry->LastResultTime < 0.0 || (Now - Entry->LastResultTime) > StalenessWindow;
+	if (bStale && !Entry->bQueued && !Entry->bTraceInFlight)
+	{
+		Entry->bQueued = true;
+		TraceQueue.Add(Key);
+	}
+
+	return Entry->bVisible;
+}
+
+void ULineOfSightSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	EvictUnusedEntries(Now);
+	StartQueuedTraces();
+}
+
+void ULineOfSightSubsystem::StartQueuedTraces()
+{
+	UWorld* World = GetWorld();
+
+	int32 NumStarted = 0;
+
+	for (; TraceQueueHead < TraceQueue.Num() && NumStarted < MaxTracesPerFrame; TraceQueueHead++)
+	{
+		const uint64 Key = TraceQueue[TraceQueueHead];
+
+		FLineOfSightEntry* Entry = Entries.Find(Key);
+		if (!Entry) continue; // Evicted while waiting
+
+		Entry->bQueued = false;
+
+		const AActor* Viewer = Entry->Viewer.Get();
+		const AActor* Target = Entry->Target.Get();
+		if (!Viewer || !Target) continue;
+
+		// Obstacles only: ignore both ends of the line
+		FCollisionQueryParams Params(SCENE_QUERY_STAT(LineOfSight), false, Viewer);
+		Params.AddIgnoredActor(Target);
+
+		const uint32 TraceId = NextTraceId++;
+		World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Viewer->GetActorLocation() + Entry->EyeOffset, Target->GetActorLocation(),
+			ECC_Visibility, Params, FCollisionResponseParams::DefaultResponseParam, &TraceDelegate, TraceId);
+
+		InFlightTraces.Add(TraceId, Key);
+		Entry->bTraceInFlight = true;
+		NumStarted++;
+	}
+
+	// Keep the rest (oldest first) for the next frames. Consumed keys are only compacted away once they make up
+	// half the buffer, so each key is moved at most once
+	if (TraceQueueHead == TraceQueue.Num())
+	{
+		TraceQueue.Reset();
+		TraceQueueHead = 0;
+	}
+	else if (TraceQueueHead * 2 >= TraceQueue.Num())
+	{
+		TraceQueue.RemoveAt(0, TraceQueueHead, EAllowShrinking::No);
+		TraceQueueHead = 0;
+	}
+}
+
+void ULineOfSightSubsystem::OnTraceCompleted(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+	uint64 Key = 0;
+	if (!InFlightTraces.RemoveAndCopyValue(Datum.UserData, Key)) return;
+
+	FLineOfSightEntry* Entry = Entries.Find(Key);
+	if (!Entry) return;
+
+	// Any blocking hit between the two means an obstacle is in the way
+	Entry->bVisible = !(Datum.OutHits.Num() > 0 && Datum.OutHits[0].bBlockingHit);
+	Entry->bTraceInFlight = false;
+	Entry->LastResultTime = GetWorld()->GetTimeSeconds();
+}
+
+void ULineOfSightSubsystem::EvictUnusedEntries(double Now)
+{
+	// Walk the cache slots a few at a time; removing by id leaves the other slots in place
+	const int32 MaxIndex = Entries.GetMaxIndex();
+	if (EvictionCursor >= MaxIndex)
+	{
+		EvictionCursor = 0;
+	}
+
+	const int32 NumChecks = FMath::Min(MaxEvictionChecksPerFrame, MaxIndex);
+	for (int32 Checked = 0; Checked < NumChecks; Checked++, EvictionCursor = (EvictionCursor + 1) % MaxIndex)
+	{
+		const FSetElementId Id = FSetElementId::FromInteger(EvictionCursor);
+		if (!Entries.IsValidId(Id)) continue;
+
+		const FLineOfSightEntry& Entry = Entries.Get(Id).Value;
+
+		const bool bActorsGone = !Entry.Viewer.IsValid() || !Entry.Target.IsValid();
+		const bool bUnused = (Now - Entry.LastRequestTime) > EvictAfter;
+
+		// Pairs still queued are skipped by StartQueuedTraces; pairs in flight are ignored by OnTraceCompleted
+		if (bActorsGone || bUnused)
+		{
+			Entries.Remove(Id);
+		}
+	}
+}
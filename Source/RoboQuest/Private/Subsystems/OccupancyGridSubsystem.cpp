@@ -0,0 +1,36 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/OccupancyGridSubsystem.h"
+#include "World/OccupancyGridVolume.h"
+
+void UOccupancyGridSubsystem::Deinitialize()
+{
+	Volumes.Empty();
+
+	Super::Deinitialize();
+}
+
+void UOccupancyGridSubsystem::RegisterVolume(AOccupancyGridVolume* Volume)
+{
+	if (Volume)
+	{
+		Volumes.AddUnique(Volume);
+	}
+}
+
+void UOccupancyGridSubsystem::UnregisterVolume(AOccupancyGridVolume* Volume)
+{
+	Volumes.RemoveSingleSwap(Volume, EAllowShrinking::No);
+}
+
+const AOccupancyGridVolume* UOccupancyGridSubsystem::FindVolume(const FVector& Location) const
+{
+	for (const TWeakObjectPtr<AOccupancyGridVolume>& Volume : Volumes)
+	{
+		if (Volume.IsValid() && Volume->ContainsLocation(Location))
+		{
+			return Volume.Get();
+		}
+	}
+	return nullptr;
+}
@@ -0,0 +1,225 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/PickupSubsystem.h"
+#include "Subsystems/TargetingSubsystem.h"
+#include "Pickups/HealingCell.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+
+namespace
+{
+	// Cells fly to the chest of the player, not its feet
+	const FVector HomingOffset(0.0f, 0.0f, 50.0f);
+}
+
+void UPickupSubsystem::Deinitialize()
+{
+	// The proxy actor belongs to the world and goes away with it
+	Groups.Empty();
+	PoppingCells.Empty();
+	ProxyActor = nullptr;
+
+	Super::Deinitialize();
+}
+
+bool UPickupSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UPickupSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UPickupSubsystem, STATGROUP_Tickables);
+}
+
+void UPickupSubsystem::AddHealingCell(const FHealingCellPickup& Cell, UStaticMesh* Mesh, const FVector& Scale)
+{
+	if (!MergeDrop(Cell.Location, Cell.HealAmount, Cell.StackCount))
+	{
+		FHealingCellPickup& NewCell = GetOrAddGroup(Mesh).Cells.Add_GetRef(Cell);
+		NewCell.Scale = Scale;
+	}
+}
+
+int32 UPickupSubsystem::GetNumHealingCells() const
+{
+	int32 NumCells = 0;
+	for (const FPickupMeshGroup& Group : Groups)
+	{
+		NumCells += Group.Cells.Num();
+	}
+	return NumCells;
+}
+
+bool UPickupSubsystem::MergeDrop(const FVector& Location, float HealAmount, int32 StackCount)
+{
+	const float Now = GetWorld()->GetTimeSeconds();
+	const float MergeRadiusSq = FMath::Square(MergeRadius);
+
+	// 1. Cells still popping
+	for (const TWeakObjectPtr<AHealingCell>& PoppingCell : PoppingCells)
+	{
+		AHealingCell* Cell = PoppingCell.Get();
+		if (Cell && Now - Cell->GetSpawnTime() <= MergeWindow && FVector::DistSquared(Cell->GetActorLocation(), Location) <= MergeRadiusSq)
+		{
+			Cell->AddToStack(HealAmount, StackCount);
+			return true;
+		}
+	}
+
+	// 2. Cells on the ground, not flying to a player yet
+	for (FPickupMeshGroup& Group : Groups)
+	{
+		for (FHealingCellPickup& Cell : Group.Cells)
+		{
+			if (!Cell.Target.IsValid() && Now - Cell.SpawnTime <= MergeWindow && FVector::DistSquared(Cell.Location, Location) <= MergeRadiusSq)
+			{
+				Cell.HealAmount += HealAmount;
+				Cell.StackCount += StackCount;
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+void UPickupSubsystem::RegisterPoppingCell(AHealingCell* Cell)
+{
+	PoppingCells.AddUnique(Cell);
+}
+
+void UPickupSubsystem::UnregisterPoppingCell(AHealingCell* Cell)
+{
+	PoppingCells.RemoveSingleSwap(Cell, EAllowShrinking::No);
+}
+
+float UPickupSubsystem::GetStackScale(int32 StackCount) const
+{
+	return FMath::Min(1.0f + StackScalePerDrop * (StackCount - 1), MaxStackScale);
+}
+
+FPickupMeshGroup& UPickupSubsystem::GetOrAddGroup(UStaticMesh* Mesh)
+{
+	const int32 Existing = Groups.IndexOfByPredicate([Mesh](const FPickupMeshGroup& It) { return It.Mesh == Mesh; });
+	if (Existing != INDEX_NONE)
+	{
+		return Groups[Existing];
+	}
+
+	FPickupMeshGroup& Group = Groups.AddDefaulted_GetRef();
+	Group.Mesh = Mesh;
+
+	if (!ProxyActor)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		ProxyActor = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+	}
+
+	if (ProxyActor && Mesh)
+	{
+		UInstancedStaticMeshComponent* Instances = NewObject<UInstancedStaticMeshComponent>(ProxyActor);
+		Instances->NumCustomDataFloats = 1; // Stack count
+		Instances->SetStaticMesh(Mesh);
+		Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		Instances->SetCastShadow(false);
+		Instances->SetMobility(EComponentMobility::Movable);
+		if (!ProxyActor->GetRootComponent())
+		{
+			ProxyActor->SetRootComponent(Instances);
+		}
+		Instances->RegisterComponent();
+		ProxyActor->AddInstanceComponent(Instances);
+
+		Group.Instances = Instances;
+	}
+
+	return Group;
+}
+
+void UPickupSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	for (FPickupMeshGroup& Group : Groups)
+	{
+		if (Group.Cells.Num() == 0 && (!Group.Instances || Group.Instances->GetInstanceCount() == 0)) continue;
+
+		UpdateCells(Group, DeltaTime);
+		RefreshInstances(Group);
+	}
+}
+
+void UPickupSubsystem::UpdateCells(FPickupMeshGroup& Group, float DeltaTime)
+{
+	const UTargetingSubsystem* Targeting = GetWorld()->GetSubsystem<UTargetingSubsystem>();
+	TArray<FHealingCellPickup>& Cells = Group.Cells;
+
+	for (int32 i = Cells.Num() - 1; i >= 0; i--)
+	{
+		FHealingCellPickup& Cell = Cells[i];
+
+		// 1. Magnet: nearest player in range (cached once per frame by UTargetingSubsystem)
+		AActor* Target = Cell.Target.Get();
+		if (!Target && Targeting)
+		{
+			Target = Targeting->FindNearestTarget(Cell.Location, Cell.MagnetDetectRange);
+			Cell.Target = Target;
+		}
+		if (!Target) continue;
+
+		// 2. Homing
+		const FVector TargetLoc = Target->GetActorLocation() + HomingOffset;
+		Cell.Location = FMath::VInterpConstantTo(Cell.Location, TargetLoc, DeltaTime, Cell.MagnetFlySpeed);
+
+		// 3. Collection: the whole stack in one heal
+		if (FVector::DistSquared(Cell.Location, TargetLoc) <= FMath::Square(Cell.CollectRadius))
+		{
+			if (AHealingCell::HealCollector(Target, Cell.HealAmount))
+			{
+				Cells.RemoveAtSwap(i, 1, EAllowShrinking::No);
+			}
+		}
+	}
+}
+
+void UPickupSubsystem::RefreshInstances(FPickupMeshGroup& Group)
+{
+	UInstancedStaticMeshComponent* Instances = Group.Instances;
+	if (!Instances) return;
+
+	const TArray<FHealingCellPickup>& Cells = Group.Cells;
+
+	// Trim/grow the instance count, then push every transform in one batch
+	const int32 NumCells = Cells.Num();
+	int32 NumInstances = Instances->GetInstanceCount();
+	while (NumInstances > NumCells)
+	{
+		Instances->RemoveInstance(--NumInstances);
+	}
+
+	InstanceTransforms.Reset(NumCells);
+	for (const FHealingCellPickup& Cell : Cells)
+	{
+		InstanceTransforms.Emplace(Cell.Rotation, Cell.Location, Cell.Scale * GetStackScale(Cell.StackCount));
+	}
+
+	if (NumInstances < NumCells)
+	{
+		TArray<FTransform> NewTransforms(&InstanceTransforms[NumInstances], NumCells - NumInstances);
+		Instances->AddInstances(NewTransforms, false, true);
+	}
+
+	if (NumInstances > 0)
+	{
+		Instances->BatchUpdateInstancesTransforms(0, TArrayView<const FTransform>(InstanceTransforms.GetData(), NumInstances), true, true, true);
+	}
+
+	// Stack counts for the material (render state marked dirty once, with the last one)
+	for (int32 i = 0; i < NumCells; i++)
+	{
+		Instances->SetCustomDataValue(i, 0, (float)Cells[i].StackCount, i == NumCells - 1);
+	}
+}
@@ -0,0 +1,195 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/ProjectilePoolSubsystem.h"
+#include "RoboQuest/RoboQuestProjectile.h"
+#include "Projectiles/RoboQuestPelletBatch.h"
+#include "Engine/World.h"
+
+namespace
+{
+	// Per-type hooks of the shared pool code
+	void ActivatePooled(ARoboQuestProjectile* Projectile, const FVector& Location, const FRotator& Rotation) { Projectile->ActivatePooledProjectile(Location, Rotation); }
+	void ActivatePooled(ARoboQuestPelletBatch* Batch, const FVector& Location, const FRotator& Rotation) { Batch->ActivatePooledBatch(Location, Rotation); }
+
+	void DeactivatePooled(ARoboQuestProjectile* Projectile) { Projectile->DeactivatePooledProjectile(); }
+	void DeactivatePooled(ARoboQuestPelletBatch* Batch) { Batch->DeactivatePooledBatch(); }
+}
+
+void UProjectilePoolSubsystem::Deinitialize()
+{
+	LogPoolStats();
+
+	// Pooled actors are owned by the world and destroyed with it
+	Pools.Empty();
+
+	Super::Deinitialize();
+}
+
+template<typename ActorType>
+void UProjectilePoolSubsystem::PrewarmActors(UClass* ActorClass, int32 Count)
+{
+	if (!ActorClass) return;
+
+	FProjectilePool& Pool = Pools.FindOrAdd(ActorClass);
+
+	while (Pool.Stats.PoolSize < Count)
+	{
+		ActorType* Actor = SpawnPooledActor<ActorType>(ActorClass);
+		if (!Actor)
+		{
+			break;
+		}
+
+		Pool.FreeActors.Add(Actor);
+		Pool.Stats.PoolSize++;
+	}
+}
+
+template<typename ActorType>
+ActorType* UProjectilePoolSubsystem::AcquireActor(UClass* ActorClass, int32 PrewarmCount, const FVector& Location, const FRotator& Rotation, AActor* NewOwner, APawn* NewInstigator)
+{
+	if (!ActorClass) return nullptr;
+
+	// First use of this class: pre-warm it
+	if (!Pools.Contains(ActorClass))
+	{
+		PrewarmActors<ActorType>(ActorClass, PrewarmCount);
+	}
+
+	FProjectilePool& Pool = Pools.FindOrAdd(ActorClass);
+
+	ActorType* Actor = nullptr;
+	while (!Actor && Pool.FreeActors.Num() > 0)
+	{
+		// Skip entries that were destroyed behind our back (e.g. level streaming)
+		AActor* Candidate = Pool.FreeActors.Pop(EAllowShrinking::No);
+		if (IsValid(Candidate))
+		{
+			Actor = CastChecked<ActorType>(Candidate);
+		}
+		else
+		{
+			Pool.Stats.PoolSize--;
+		}
+	}
+
+	if (!Actor)
+	{
+		// Pool ran dry: grow it
+		Pool.Stats.Misses++;
+
+		Actor = SpawnPooledActor<ActorType>(ActorClass);
+		if (!Actor)
+		{
+			return nullptr;
+		}
+		Pool.Stats.PoolSize++;
+	}
+
+	Pool.Stats.ActiveCount++;
+	Pool.Stats.HighWaterMark = FMath::Max(Pool.Stats.HighWaterMark, Pool.Stats.ActiveCount);
+
+	Actor->SetOwner(NewOwner);
+	Actor->SetInstigator(NewInstigator);
+	ActivatePooled(Actor, Location, Rotation);
+
+	return Actor;
+}
+
+template<typename ActorType>
+void UProjectilePoolSubsystem::ReleaseActor(ActorType* Actor)
+{
+	if (!IsValid(Actor)) return;
+
+	FProjectilePool* Pool = Actor->IsPooled() ? Pools.Find(Actor->GetClass()) : nullptr;
+	if (!Pool)
+	{
+		// Not one of ours (e.g. placed in the level or spawned directly)
+		Actor->Destroy();
+		return;
+	}
+
+	if (!Actor->IsInFlight())
+	{
+		// Already back in the pool
+		return;
+	}
+
+	DeactivatePooled(Actor);
+	Actor->SetOwner(nullptr);
+	Actor->SetInstigator(nullptr);
+
+	Pool->FreeActors.Add(Actor);
+	Pool->Stats.ActiveCount = FMath::Max(0, Pool->Stats.ActiveCount - 1);
+}
+
+template<typename ActorType>
+ActorType* UProjectilePoolSubsystem::SpawnPooledActor(UClass* ActorClass)
+{
+	UWorld* World = GetWorld();
+	if (!World) return nullptr;
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	ActorType* Actor = World->SpawnActor<ActorType>(ActorClass, FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
+	if (Actor)
+	{
+		Actor->MarkAsPooled();
+		DeactivatePooled(Actor);
+	}
+
+	return Actor;
+}
+
+void UProjectilePoolSubsystem::PrewarmPool(TSubclassOf<ARoboQuestProjectile> ProjectileClass, int32 Count)
+{
+	PrewarmActors<ARoboQuestProjectile>(ProjectileClass, Count);
+}
+
+void UProjectilePoolSubsystem::PrewarmPelletBatches(TSubclassOf<ARoboQuestPelletBatch> BatchClass, int32 Count)
+{
+	PrewarmActors<ARoboQuestPelletBatch>(BatchClass, Count);
+}
+
+ARoboQuestProjectile* UProjectilePoolSubsystem::AcquireProjectile(TSubclassOf<ARoboQuestProjectile> ProjectileClass, const FVector& Location, const FRotator& Rotation, AActor* NewOwner, APawn* NewInstigator)
+{
+	return AcquireActor<ARoboQuestProjectile>(ProjectileClass, DefaultPrewarmCount, Location, Rotation, NewOwner, NewInstigator);
+}
+
+void UProjectilePoolSubsystem::ReleaseProjectile(ARoboQuestProjectile* Projectile)
+{
+	ReleaseActor(Projectile);
+}
+
+ARoboQuestPelletBatch* UProjectilePoolSubsystem::AcquirePelletBatch(TSubclassOf<ARoboQuestPelletBatch> BatchClass, const FVector& Location, const FRotator& Rotation, AActor* NewOwner, APawn* NewInstigator)
+{
+	return AcquireActor<ARoboQuestPelletBatch>(BatchClass, DefaultPelletBatchPrewarmCount, Location, Rotation, NewOwner, NewInstigator);
+}
+
+void UProjectilePoolSubsystem::ReleasePelletBatch(ARoboQuestPelletBatch* Batch)
+{
+	ReleaseActor(Batch);
+}
+
+FProjectilePoolStats UProjectilePoolSubsystem::GetPoolStats(TSubclassOf<ARoboQuestProjectile> ProjectileClass) const
+{
+	const FProjectilePool* Pool = Pools.Find(ProjectileClass);
+	return Pool ? Pool->Stats : FProjectilePoolStats();
+}
+
+FProjectilePoolStats UProjectilePoolSubsystem::GetPelletBatchPoolStats(TSubclassOf<ARoboQuestPelletBatch> BatchClass) const
+{
+	const FProjectilePool* Pool = Pools.Find(BatchClass);
+	return Pool ? Pool->Stats : FProjectilePoolStats();
+}
+
+void UProjectilePoolSubsystem::LogPoolStats() const
+{
+	for (const TPair<TObjectPtr<UClass>, FProjectilePool>& Pair : Pools)
+	{
+		const FProjectilePoolStats& Stats = Pair.Value.Stats;
+		UE_LOG(LogTemp, Log, TEXT("UProjectilePoolSubsystem:: %s PoolSize: %d, Active: %d, HighWaterMark: %d, Misses: %d"),
+			*GetNameSafe(Pair.Key), Stats.PoolSize, Stats.ActiveCount, Stats.HighWaterMark, Stats.Misses);
+	}
+}
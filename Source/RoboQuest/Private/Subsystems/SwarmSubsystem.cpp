@@ -0,0 +1,291 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/SwarmSubsystem.h"
+#include "Subsystems/EnemyPoolSubsystem.h"
+#include "Subsystems/TargetingSubsystem.h"
+#include "Enemy/EnemyBase.h"
+#include "Enemy/EnemyFlyBase.h"
+#include "Components/StatusComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Engine/World.h"
+#include "RoboQuest/RoboQuest.h"
+
+void USwarmSubsystem::Deinitialize()
+{
+	// The proxy actor and promoted enemies belong to the world and go away with it
+	Classes.Empty();
+	Promoted.Empty();
+	ProxyActor = nullptr;
+
+	SET_DWORD_STAT(STAT_SwarmEntities, 0);
+	SET_DWORD_STAT(STAT_SwarmPromotedActors, 0);
+
+	Super::Deinitialize();
+}
+
+bool USwarmSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId USwarmSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USwarmSubsystem, STATGROUP_Tickables);
+}
+
+int32 USwarmSubsystem::GetNumEntities() const
+{
+	int32 Num = 0;
+	for (const FSwarmClass& SwarmClass : Classes)
+	{
+		Num += SwarmClass.Entities.Num();
+	}
+	return Num;
+}
+
+int32 USwarmSubsystem::GetOrAddClass(TSubclassOf<AEnemyBase> EnemyClass)
+{
+	const int32 Existing = Classes.IndexOfByPredicate([EnemyClass](const FSwarmClass& It) { return It.EnemyClass == EnemyClass; });
+	if (Existing != INDEX_NONE) return Existing;
+
+	UWorld* World = GetWorld();
+	if (!ProxyActor)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		ProxyActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+	}
+
+	FSwarmClass& SwarmClass = Classes.AddDefaulted_GetRef();
+	SwarmClass.EnemyClass = EnemyClass;
+
+	const AEnemyBase* EnemyCDO = EnemyClass->GetDefaultObject<AEnemyBase>();
+	SwarmClass.ProxyScale = EnemyCDO->SwarmProxyScale;
+
+	// Flying classes hover around their target; anything else (pods) stays put and only turns
+	if (const AEnemyFlyBase* FlyCDO = Cast<AEnemyFlyBase>(EnemyCDO))
+	{
+		const float MaxFlySpeed = FlyCDO->GetCharacterMovement() ? FlyCDO->GetCharacterMovement()->MaxFlySpeed : 0.0f;
+		SwarmClass.Speed = FlyCDO->bEnableHovering ? MaxFlySpeed * FlyCDO->HoverMoveScale : 0.0f;
+		SwarmClass.PreferredMinRange = FlyCDO->PreferredMinRange;
+		SwarmClass.PreferredMaxRange = FlyCDO->PreferredMaxRange;
+		SwarmClass.HoverChangeInterval = FlyCDO->HoverChangeInterval;
+	}
+
+	if (ProxyActor && EnemyCDO->SwarmProxyMesh)
+	{
+		UInstancedStaticMeshComponent* Instances = NewObject<UInstancedStaticMeshComponent>(ProxyActor);
+		Instances->SetStaticMesh(EnemyCDO->SwarmProxyMesh);
+		Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		Instances->SetCastShadow(false);
+		Instances->SetMobility(EComponentMobility::Movable);
+		if (!ProxyActor->GetRootComponent())
+		{
+			ProxyActor->SetRootComponent(Instances);
+		}
+		Instances->RegisterComponent();
+		ProxyActor->AddInstanceComponent(Instances);
+
+		SwarmClass.Instances = Instances;
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("USwarmSubsystem:: %s has no SwarmProxyMesh, its swarm entities are invisible"), *GetNameSafe(EnemyClass));
+	}
+
+	return Classes.Num() - 1;
+}
+
+void USwarmSubsystem::AddSwarmEntity(TSubclassOf<AEnemyBase> EnemyClass, const FVector& Location, const FRotator& Rotation)
+{
+	if (!EnemyClass) return;
+
+	FSwarmClass& SwarmClass = Classes[GetOrAddClass(EnemyClass)];
+
+	FSwarmEntity& Entity = SwarmClass.Entities.AddDefaulted_GetRef();
+	Entity.Location = Location;
+	Entity.Rotation = Rotation;
+
+	// Desync the hover changes of the swarm
+	Entity.HoverTimeLeft = FMath::FRandRange(0.0f, SwarmClass.HoverChangeInterval);
+}
+
+FVector USwarmSubsystem::PickHoverDirection(const FSwarmClass& SwarmClass, const FVector& Location, const AActor* Target) const
+{
+	FVector NewDir = FMath::VRand();
+	NewDir.Z *= 0.25f; // Flatten vertical movement
+
+	if (Target)
+	{
+		const FVector ToTarget = Target->GetActorLocation() - Location;
+		const float Dist = ToTarget.Size();
+		const FVector DirToTarget = ToTarget.GetSafeNormal();
+
+		if (Dist > SwarmClass.PreferredMaxRange)
+		{
+			// Pull closer
+			NewDir = (NewDir * 0.5f + DirToTarget).GetSafeNormal();
+		}
+		else if (Dist < SwarmClass.PreferredMinRange)
+		{
+			// Push away
+			NewDir = (NewDir * 0.5f - DirToTarget).GetSafeNormal();
+		}
+		else
+		{
+			// Orbit
+			FVector OrbitDir = FVector::CrossProduct(DirToTarget, FVector::UpVector);
+			if (FMath::RandBool()) OrbitDir *= -1.0f;
+			NewDir = (OrbitDir + NewDir * 0.5f).GetSafeNormal();
+		}
+	}
+
+	// No ground/wall probes out here: keep entities at their altitude
+	NewDir.Z = 0.0f;
+	return NewDir.GetSafeNormal();
+}
+
+void USwarmSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	DemoteFarEnemies();
+
+	int32 NumPromotions = 0;
+	for (int32 ClassIndex = 0; ClassIndex < Classes.Num(); ClassIndex++)
+	{
+		UpdateClass(Classes[ClassIndex], ClassIndex, DeltaTime, NumPromotions);
+	}
+
+	SET_DWORD_STAT(STAT_SwarmEntities, GetNumEntities());
+	SET_DWORD_STAT(STAT_SwarmPromotedActors, Promoted.Num());
+}
+
+void USwarmSubsystem::UpdateClass(FSwarmClass& SwarmClass, int32 ClassIndex, float DeltaTime, int32& NumPromotions)
+{
+	const UTargetingSubsystem* Targeting = GetWorld()->GetSubsystem<UTargetingSubsystem>();
+	const float PromoteDistanceSq = FMath::Square(PromoteDistance);
+
+	TArray<FSwarmEntity>& Entities = SwarmClass.Entities;
+	for (int32 i = Entities.Num() - 1; i >= 0; i--)
+	{
+		FSwarmEntity& Entity = Entities[i];
+		const AActor* Target = Targeting ? Targeting->FindNearestTarget(Entity.Location, 0.0f) : nullptr;
+
+		// Close to a player: become a real enemy
+		if (Target && NumPromotions < MaxPromotionsPerFrame && FVector::DistSquared(Entity.Location, Target->GetActorLocation()) <= PromoteDistanceSq)
+		{
+			if (Promote(SwarmClass, ClassIndex, Entity))
+			{
+				NumPromotions++;
+				Entities.RemoveAtSwap(i, 1, EAllowShrinking::No);
+				continue;
+			}
+		}
+
+		// Hover model: periodically re-picked direction at constant speed, always facing the target
+		if (SwarmClass.Speed > 0.0f)
+		{
+			Entity.HoverTimeLeft -= DeltaTime;
+			if (Entity.HoverTimeLeft <= 0.0f)
+			{
+				Entity.HoverDirection = PickHoverDirection(SwarmClass, Entity.Location, Target);
+				Entity.HoverTimeLeft = SwarmClass.HoverChangeInterval;
+			}
+			Entity.Location += Entity.HoverDirection * SwarmClass.Speed * DeltaTime;
+		}
+
+		if (Target)
+		{
+			Entity.Rotation = UKismetMathLibrary::FindLookAtRotation(Entity.Location, Target->GetActorLocation());
+		}
+	}
+
+	UInstancedStaticMeshComponent* Instances = SwarmClass.Instances;
+	if (!Instances) return;
+
+	// Instance i draws entity i: trim/grow the instance count, then push every transform in one batch
+	const int32 NumEntities = Entities.Num();
+	int32 NumInstances = Instances->GetInstanceCount();
+	while (NumInstances > NumEntities)
+	{
+		Instances->RemoveInstance(--NumInstances);
+	}
+
+	InstanceTransforms.Reset(NumEntities);
+	for (const FSwarmEntity& Entity : Entities)
+	{
+		InstanceTransforms.Emplace(Entity.Rotation, Entity.Location, SwarmClass.ProxyScale);
+	}
+
+	if (NumInstances < NumEntities)
+	{
+		TArray<FTransform> NewTransforms(&InstanceTransforms[NumInstances], NumEntities - NumInstances);
+		Instances->AddInstances(NewTransforms, false, true);
+	}
+
+	if (NumInstances > 0)
+	{
+		Instances->BatchUpdateInstancesTransforms(0, TArrayView<const FTransform>(InstanceTransforms.GetData(), NumInstances), true, true, true);
+	}
+}
+
+AEnemyBase* USwarmSubsystem::Promote(const FSwarmClass& SwarmClass, int32 ClassIndex, const FSwarmEntity& Entity)
+{
+	AEnemyBase* Enemy = nullptr;
+	if (UEnemyPoolSubsystem* Pool = GetWorld()->GetSubsystem<UEnemyPoolSubsystem>())
+	{
+		Enemy = Pool->AcquireEnemy(SwarmClass.EnemyClass, Entity.Location, Entity.Rotation);
+	}
+	if (!Enemy) return nullptr;
+
+	// Damage taken before the swarm pulled back out stays
+	if (Enemy->StatusComponent && Entity.HealthFraction < 1.0f)
+	{
+		Enemy->StatusComponent->SetCurrentHealth(Enemy->StatusComponent->MaxHealth * Entity.HealthFraction);
+	}
+
+	Promoted.Add({ Enemy, ClassIndex });
+	return Enemy;
+}
+
+void USwarmSubsystem::DemoteFarEnemies()
+{
+	const UTargetingSubsystem* Targeting = GetWorld()->GetSubsystem<UTargetingSubsystem>();
+	UEnemyPoolSubsystem* Pool = GetWorld()->GetSubsystem<UEnemyPoolSubsystem>();
+	const float DemoteDistanceSq = FMath::Square(DemoteDistance);
+
+	int32 NumDemotions = 0;
+	for (int32 i = Promoted.Num() - 1; i >= 0; i--)
+	{
+		AEnemyBase* Enemy = Promoted[i].Enemy.Get();
+
+		// Killed (its corpse goes back to the pool on its own) or destroyed: no longer part of the swarm
+		if (!Enemy || !Enemy->IsAlive())
+		{
+			Promoted.RemoveAtSwap(i, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		if (NumDemotions >= MaxDemotionsPerFrame || !Pool) continue;
+
+		const AActor* Target = Targeting ? Targeting->FindNearestTarget(Enemy->GetActorLocation(), 0.0f) : nullptr;
+		if (Target && FVector::DistSquared(Enemy->GetActorLocation(), Target->GetActorLocation()) <= DemoteDistanceSq) continue;
+
+		FSwarmClass& SwarmClass = Classes[Promoted[i].ClassIndex];
+		FSwarmEntity& Entity = SwarmClass.Entities.AddDefaulted_GetRef();
+		Entity.Location = Enemy->GetActorLocation();
+		Entity.Rotation = Enemy->GetActorRotation();
+		Entity.HoverTimeLeft = 0.0f;
+		if (Enemy->StatusComponent && Enemy->StatusComponent->MaxHealth > 0.0f)
+		{
+			Entity.HealthFraction = Enemy->StatusComponent->CurrentHealth / Enemy->StatusComponent->MaxHealth;
+		}
+
+		Pool->ReleaseEnemy(Enemy);
+		Promoted.RemoveAtSwap(i, 1, EAllowShrinking::No);
+		NumDemotions++;
+	}
+}
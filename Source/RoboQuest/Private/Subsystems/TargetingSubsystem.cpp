@@ -0,0 +1,190 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/TargetingSubsystem.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+#include "Engine/World.h"
+
+void UTargetingSubsystem::Deinitialize()
+{
+	Targets.Empty();
+	TargetGrid.Empty();
+	Seekers.Empty();
+	SeekerIndices.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UTargetingSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UTargetingSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTargetingSubsystem, STATGROUP_Tickables);
+}
+
+void UTargetingSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	RefreshTargets();
+	ResolveSeekers();
+}
+
+void UTargetingSubsystem::RegisterSeeker(AActor* Seeker, float Range)
+{
+	if (!Seeker) return;
+
+	if (const int32* Index = SeekerIndices.Find(Seeker))
+	{
+		Seekers[*Index].Range = Range;
+		return;
+	}
+
+	FSeekerEntry& Entry = Seekers.AddDefaulted_GetRef();
+	Entry.Seeker = Seeker;
+	Entry.Range = Range;
+
+	// Resolve right away so the seeker doesn't wait for the next update
+	const int32 TargetIndex = FindNearestTargetIndex(Seeker->GetActorLocation(), Range);
+	Entry.Target = Targets.IsValidIndex(TargetIndex) ? Targets[TargetIndex].Actor : nullptr;
+
+	SeekerIndices.Add(Seeker, Seekers.Num() - 1);
+}
+
+void UTargetingSubsystem::UnregisterSeeker(AActor* Seeker)
+{
+	int32 Index = INDEX_NONE;
+	if (!SeekerIndices.RemoveAndCopyValue(Seeker, Index)) return;
+
+	Seekers.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+	// Fix up the index of the entry that was moved into the hole
+	if (Seekers.IsValidIndex(Index))
+	{
+		if (AActor* Moved = Seekers[Index].Seeker.Get())
+		{
+			SeekerIndices.Add(Moved, Index);
+		}
+	}
+}
+
+AActor* UTargetingSubsystem::GetTargetFor(const AActor* Seeker) const
+{
+	const int32* Index = SeekerIndices.Find(Seeker);
+	return Index ? Seekers[*Index].Target.Get() : nullptr;
+}
+
+AActor* UTargetingSubsystem::FindNearestTarget(const FVector& Location, float Range) const
+{
+	const int32 Index = FindNearestTargetIndex(Location, Range);
+	return Targets.IsValidIndex(Index) ? Targets[Index].Actor.Get() : nullptr;
+}
+
+void UTargetingSubsystem::RefreshTargets()
+{
+	Targets.Reset();
+	TargetGrid.Reset();
+
+	UWorld* World = GetWorld();
+	if (!World) return;
+
+	// Every pawn possessed by a player is a target
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		APawn* Pawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+		if (!IsValid(Pawn) || Pawn->IsHidden()) continue;
+
+		FTargetEntry& Entry = Targets.AddDefaulted_GetRef();
+		Entry.Actor = Pawn;
+		Entry.Location = Pawn->GetActorLocation();
+	}
+
+	for (int32 i = 0; i < Targets.Num(); i++)
+	{
+		TargetGrid.FindOrAdd(GetCell(Targets[i].Location)).Add(i);
+	}
+}
+
+void UTargetingSubsystem::ResolveSeekers()
+{
+	for (int32 i = Seekers.Num() - 1; i >= 0; i--)
+	{
+		FSeekerEntry& Entry = Seekers[i];
+
+		const AActor* Seeker = Entry.Seeker.Get();
+		if (!Seeker)
+		{
+			// Destroyed without unregistering: drop it
+			Seekers.RemoveAtSwap(i, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		const int32 TargetIndex = FindNearestTargetIndex(Seeker->GetActorLocation(), Entry.Range);
+		Entry.Target = Targets.IsValidIndex(TargetIndex) ? Targets[TargetIndex].Actor : nullptr;
+	}
+
+	// Dead entries may have been swapped around: rebuild the lookup if the count no longer matches
+	if (SeekerIndices.Num() != Seekers.Num())
+	{
+		SeekerIndices.Reset();
+		for (int32 i = 0; i < Seekers.Num(); i++)
+		{
+			SeekerIndices.Add(Seekers[i].Seeker.Get(), i);
+		}
+	}
+}
+
+FIntPoint UTargetingSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+int32 UTargetingSubsystem::FindNearestTargetIndex(const FVector& Location, float Range) const
+{
+	int32 BestIndex = INDEX_NONE;
+	float BestDistSq = (Range > 0.0f) ? FMath::Square(Range) : TNumericLimits<float>::Max();
+
+	// Few targets (the usual single player) or unlimited range: just scan them
+	if (Targets.Num() <= LinearScanThreshold || Range <= 0.0f)
+	{
+		for (int32 i = 0; i < Targets.Num(); i++)
+		{
+			const float DistSq = FVector::DistSquared(Location, Targets[i].Location);
+			if (DistSq <= BestDistSq)
+			{
+				BestDistSq = DistSq;
+				BestIndex = i;
+			}
+		}
+		return BestIndex;
+	}
+
+	// Walk only the grid cells overlapping the range
+	const int32 CellRadius = FMath::CeilToInt(Range / CellSize);
+	const FIntPoint Center = GetCell(Location);
+
+	for (int32 X = Center.X - CellRadius; X <= Center.X + CellRadius; X++)
+	{
+		for (int32 Y = Center.Y - CellRadius; Y <= Center.Y + CellRadius; Y++)
+		{
+			const TArray<int32>* Cell = TargetGrid.Find(FIntPoint(X, Y));
+			if (!Cell) continue;
+
+			for (const int32 i : *Cell)
+			{
+				const float DistSq = FVector::DistSquared(Location, Targets[i].Location);
+				if (DistSq <= BestDistSq)
+				{
+					BestDistSq = DistSq;
+					BestIndex = i;
+				}
+			}
+		}
+	}
+
+	return BestIndex;
+}
@@ -0,0 +1,331 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "World/OccupancyGridVolume.h"
+#include "Subsystems/OccupancyGridSubsystem.h"
+#include "Components/BoxComponent.h"
+#include "GameFramework/Pawn.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/PlatformTime.h"
+
+AOccupancyGridVolume::AOccupancyGridVolume()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	Bounds = CreateDefaultSubobject<UBoxComponent>(TEXT("Bounds"));
+	SetRootComponent(Bounds);
+
+	// Default size, meant to be scaled in the level
+	Bounds->SetBoxExtent(FVector(4000.f, 4000.f, 1000.f));
+	Bounds->SetCollisionProfileName(TEXT("NoCollision"));
+	Bounds->SetCanEverAffectNavigation(false);
+}
+
+void AOccupancyGridVolume::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (!IsGridBuilt())
+	{
+#if WITH_EDITOR
+		if (bBuildIfMissing && GetWorld()->IsPlayInEditor())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("AOccupancyGridVolume:: %s was saved without a grid, building it now (use Build Grid in the editor)"), *GetName());
+			BuildGrid();
+		}
+#endif
+		if (!IsGridBuilt())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("AOccupancyGridVolume:: %s was saved without a grid, flying enemies use physics sweeps in it (use Build Grid in the editor)"), *GetName());
+		}
+	}
+
+	if (GridData.IsBuilt())
+	{
+		SharedGridData = MakeShared<const FOccupancyGridData, ESPMode::ThreadSafe>(MoveTemp(GridData));
+	}
+
+	// The primitives, not the actors: their bounds are kept up to date when they move
+	DynamicPrimitives.Reset();
+	for (AActor* Obstacle : DynamicObstacles)
+	{
+		if (!Obstacle) continue;
+
+		TInlineComponentArray<UPrimitiveComponent*> Primitives(Obstacle);
+		for (UPrimitiveComponent* Primitive : Primitives)
+		{
+			if (Primitive->GetCollisionResponseToChannel(ECC_WorldStatic) == ECR_Block)
+			{
+				DynamicPrimitives.Add(Primitive);
+			}
+		}
+	}
+
+	if (UOccupancyGridSubsystem* Grids = GetWorld()->GetSubsystem<UOccupancyGridSubsystem>())
+	{
+		Grids->RegisterVolume(this);
+	}
+}
+
+void AOccupancyGridVolume::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UOccupancyGridSubsystem* Grids = GetWorld()->GetSubsystem<UOccupancyGridSubsystem>())
+	{
+		Grids->UnregisterVolume(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AOccupancyGridVolume::BuildGrid()
+{
+	UWorld* World = GetWorld();
+	if (!World || !Bounds) return;
+
+	const double StartTime = FPlatformTime::Seconds();
+	const FBox Box = Bounds->Bounds.GetBox();
+
+	const FIntVector NewNumVoxels(
+		FMath::Max(1, FMath::CeilToInt(Box.GetSize().X / VoxelSize)),
+		FMath::Max(1, FMath::CeilToInt(Box.GetSize().Y / VoxelSize)),
+		FMath::Max(1, FMath::CeilToInt(Box.GetSize().Z / VoxelSize)));
+
+	const int64 TotalVoxels = (int64)NewNumVoxels.X * NewNumVoxels.Y * NewNumVoxels.Z;
+	if (TotalVoxels > MaxVoxels)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("AOccupancyGridVolume:: %s needs %lld voxels (MaxVoxels %d), increase VoxelSize or shrink the box"), *GetName(), TotalVoxels, MaxVoxels);
+		return;
+	}
+
+	Modify();
+
+	constexpr int32 BrickSize = FOccupancyGridData::BrickSize;
+	FOccupancyGridData& Grid = GridData;
+	Grid.Origin = Box.Min;
+	Grid.VoxelSize = VoxelSize;
+	Grid.MaxDistance = MaxDistance;
+	Grid.NumVoxels = NewNumVoxels;
+	Grid.NumBricks = FIntVector(
+		FMath::DivideAndRoundUp(NewNumVoxels.X, BrickSize),
+		FMath::DivideAndRoundUp(NewNumVoxels.Y, BrickSize),
+		FMath::DivideAndRoundUp(NewNumVoxels.Z, BrickSize));
+
+	// 1. Movable blocking objects are not baked: enemies fall back to sweeps near them
+	DynamicObstacles.Reset();
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		AActor* Actor = *It;
+		if (Actor == this || Actor->IsA<APawn>()) continue;
+
+		TInlineComponentArray<UPrimitiveComponent*> Primitives(Actor);
+		for (const UPrimitiveComponent* Primitive : Primitives)
+		{
+			if (Primitive->Mobility == EComponentMobility::Movable && Primitive->IsCollisionEnabled()
+				&& Primitive->GetCollisionResponseToChannel(ECC_WorldStatic) == ECR_Block
+				&& Primitive->Bounds.GetBox().Intersect(Box))
+			{
+				DynamicObstacles.Add(Actor);
+				break;
+			}
+		}
+	}
+
+	// 2. Rasterize: a voxel is solid when it overlaps static geometry. The grid is padded to whole bricks.
+	const FIntVector Padded = Grid.NumBricks * BrickSize;
+	const int32 StrideY = Padded.X;
+	const int32 StrideZ = Padded.X * Padded.Y;
+
+	TArray<float> Distances;
+	Distances.Init(BIG_NUMBER, Padded.X * Padded.Y * Padded.Z);
+
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(OccupancyGridBuild), false, this);
+	Params.AddIgnoredActors(DynamicObstacles);
+	const FCollisionObjectQueryParams ObjectParams(ECC_WorldStatic);
+	const FCollisionShape VoxelShape = FCollisionShape::MakeBox(FVector(VoxelSize * 0.5f));
+
+	for (int32 Z = 0; Z < Grid.NumVoxels.Z; Z++)
+	{
+		for (int32 Y = 0; Y < Grid.NumVoxels.Y; Y++)
+		{
+			for (int32 X = 0; X < Grid.NumVoxels.X; X++)
+			{
+				if (World->OverlapAnyTestByObjectType(Grid.VoxelToWorld(FIntVector(X, Y, Z)), FQuat::Identity, ObjectParams, VoxelShape, Params))
+				{
+					Distances[X + Y * StrideY + Z * StrideZ] = 0.0f;
+				}
+			}
+		}
+	}
+
+	// 3. Distance transform (two-pass 3D chamfer, in voxels): each pass looks at the 13 neighbors already visited
+	struct FChamferOffset { int32 X, Y, Z; float Weight; };
+	TArray<FChamferOffset> Offsets;
+	for (int32 Z = -1; Z <= 0; Z++)
+	{
+		for (int32 Y = -1; Y <= 1; Y++)
+		{
+			for (int32 X = -1; X <= 1; X++)
+			{
+				const bool bVisitedBefore = (Z < 0) || (Y < 0) || (Y == 0 && X < 0);
+				if (bVisitedBefore)
+				{
+					Offsets.Add({ X, Y, Z, FMath::Sqrt((float)(X * X + Y * Y + Z * Z)) });
+				}
+			}
+		}
+	}
+
+	auto Relax = [&](int32 X, int32 Y, int32 Z, int32 Sign)
+	{
+		float& Distance = Distances[X + Y * StrideY + Z * StrideZ];
+		for (const FChamferOffset& Offset : Offsets)
+		{
+			const int32 NX = X + Offset.X * Sign;
+			const int32 NY = Y + Offset.Y * Sign;
+			const int32 NZ = Z + Offset.Z * Sign;
+			if (NX < 0 || NY < 0 || NZ < 0 || NX >= Padded.X || NY >= Padded.Y || NZ >= Padded.Z) continue;
+
+			Distance = FMath::Min(Distance, Distances[NX + NY * StrideY + NZ * StrideZ] + Offset.Weight);
+		}
+	};
+
+	for (int32 Z = 0; Z < Padded.Z; Z++)
+		for (int32 Y = 0; Y < Padded.Y; Y++)
+			for (int32 X = 0; X < Padded.X; X++)
+				Relax(X, Y, Z, 1);
+
+	for (int32 Z = Padded.Z - 1; Z >= 0; Z--)
+		for (int32 Y = Padded.Y - 1; Y >= 0; Y--)
+			for (int32 X = Padded.X - 1; X >= 0; X--)
+				Relax(X, Y, Z, -1);
+
+	// 4. Quantize into bricks; uniform bricks (all free or all solid) store no voxels
+	constexpr int32 VoxelsPerBrick = FOccupancyGridData::VoxelsPerBrick;
+	Grid.BrickIndices.Reset(Grid.NumBricks.X * Grid.NumBricks.Y * Grid.NumBricks.Z);
+	Grid.BrickDistances.Reset();
+
+	uint8 BrickValues[VoxelsPerBrick];
+	for (int32 BZ = 0; BZ < Grid.NumBricks.Z; BZ++)
+	{
+		for (int32 BY = 0; BY < Grid.NumBricks.Y; BY++)
+		{
+			for (int32 BX = 0; BX < Grid.NumBricks.X; BX++)
+			{
+				bool bAllFree = true;
+				bool bAllSolid = true;
+				for (int32 i = 0; i < VoxelsPerBrick; i++)
+				{
+					const int32 X = BX * BrickSize + i % BrickSize;
+					const int32 Y = BY * BrickSize + (i / BrickSize) % BrickSize;
+					const int32 Z = BZ * BrickSize + i / (BrickSize * BrickSize);
+
+					// From the center of the nearest solid voxel to its surface
+					const float VoxelDistance = Distances[X + Y * StrideY + Z * StrideZ];
+					const float Distance = FMath::Min(FMath::Max(0.0f, VoxelDistance - 0.5f) * Grid.VoxelSize, Grid.MaxDistance);
+					const bool bSolid = (VoxelDistance == 0.0f);
+
+					BrickValues[i] = bSolid ? 0 : (uint8)FMath::Clamp(FMath::RoundToInt(Distance / Grid.MaxDistance * 255.0f), 1, 255);
+					bAllFree &= (BrickValues[i] == 255);
+					bAllSolid &= bSolid;
+				}
+
+				if (bAllFree)
+				{
+					Grid.BrickIndices.Add(FOccupancyGridData::FreeBrick);
+				}
+				else if (bAllSolid)
+				{
+					Grid.BrickIndices.Add(FOccupancyGridData::SolidBrick);
+				}
+				else
+				{
+					Grid.BrickIndices.Add(Grid.BrickDistances.Num() / VoxelsPerBrick);
+					Grid.BrickDistances.Append(BrickValues, VoxelsPerBrick);
+				}
+			}
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("AOccupancyGridVolume:: %s built %dx%dx%d voxels, %d/%d bricks stored (%d KB), %d dynamic obstacles, %.1f ms"),
+		*GetName(), Grid.NumVoxels.X, Grid.NumVoxels.Y, Grid.NumVoxels.Z, Grid.BrickDistances.Num() / VoxelsPerBrick, Grid.BrickIndices.Num(),
+		Grid.BrickDistances.Num() / 1024, DynamicObstacles.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+bool AOccupancyGridVolume::ContainsLocation(const FVector& Location) const
+{
+	const FOccupancyGridData& Grid = GetGridData();
+	return Grid.IsBuilt() && Grid.IsInside(Grid.WorldToVoxel(Location));
+}
+
+bool AOccupancyGridVolume::IsNearDynamicObstacle(const FVector& Location, float Radius) const
+{
+	const float RadiusSq = FMath::Square(Radius);
+	for (const TWeakObjectPtr<UPrimitiveComponent>& Primitive : DynamicPrimitives)
+	{
+		if (Primitive.IsValid() && Primitive->IsCollisionEnabled() && Primitive->Bounds.GetBox().ComputeSquaredDistanceToPoint(Location) <= RadiusSq)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+FIntVector FOccupancyGridData::WorldToVoxel(const FVector& Location) const
+{
+	const FVector Local = (Location - Origin) / VoxelSize;
+	return FIntVector(FMath::FloorToInt(Local.X), FMath::FloorToInt(Local.Y), FMath::FloorToInt(Local.Z));
+}
+
+FVector FOccupancyGridData::VoxelToWorld(const FIntVector& Voxel) const
+{
+	return Origin + (FVector(Voxel) + FVector(0.5f)) * VoxelSize;
+}
+
+bool FOccupancyGridData::IsInside(const FIntVector& Voxel) const
+{
+	return Voxel.X >= 0 && Voxel.Y >= 0 && Voxel.Z >= 0 && Voxel.X < NumVoxels.X && Voxel.Y < NumVoxels.Y && Voxel.Z < NumVoxels.Z;
+}
+
+uint8 FOccupancyGridData::GetVoxelValue(const FIntVector& Voxel) const
+{
+	// Outside the grid: nothing known, treat as free
+	if (!IsInside(Voxel)) return 255;
+
+	const FIntVector Brick(Voxel.X / BrickSize, Voxel.Y / BrickSize, Voxel.Z / BrickSize);
+	const int32 Entry = BrickIndices[Brick.X + Brick.Y * NumBricks.X + Brick.Z * NumBricks.X * NumBricks.Y];
+	if (Entry == FreeBrick) return 255;
+	if (Entry == SolidBrick) return 0;
+
+	const int32 Local = (Voxel.X % BrickSize) + (Voxel.Y % BrickSize) * BrickSize + (Voxel.Z % BrickSize) * BrickSize * BrickSize;
+	return BrickDistances[Entry * VoxelsPerBrick + Local];
+}
+
+uint8 FOccupancyGridData::QuantizeDistance(float Distance) const
+{
+	return (uint8)FMath::Clamp(FMath::CeilToInt(Distance / MaxDistance * 255.0f), 0, 255);
+}
+
+float FOccupancyGridData::SampleDistance(const FVector& Location) const
+{
+	if (!IsBuilt()) return MaxDistance;
+
+	return GetVoxelValue(WorldToVoxel(Location)) * (MaxDistance / 255.0f);
+}
+
+float FOccupancyGridData::SampleDistanceAndGradient(const FVector& Location, FVector& OutGradient) const
+{
+	OutGradient = FVector::ZeroVector;
+	if (!IsBuilt()) return MaxDistance;
+
+	const FIntVector Voxel = WorldToVoxel(Location);
+	const uint8 Center = GetVoxelValue(Voxel);
+	if (Center == 255) return MaxDistance; // Nothing nearby, no push
+
+	// Central differences: points from the geometry towards open space
+	OutGradient = FVector(
+		(float)GetVoxelValue(Voxel + FIntVector(1, 0, 0)) - GetVoxelValue(Voxel - FIntVector(1, 0, 0)),
+		(float)GetVoxelValue(Voxel + FIntVector(0, 1, 0)) - GetVoxelValue(Voxel - FIntVector(0, 1, 0)),
+		(float)GetVoxelValue(Voxel + FIntVector(0, 0, 1)) - GetVoxelValue(Voxel - FIntVector(0, 0, 1))).GetSafeNormal();
+
+	return Center * (MaxDistance / 255.0f);
+}
@@ -0,0 +1,104 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "EnemyPerceptionComponent.generated.h"
+
+// How an enemy last sensed its target
+UENUM(BlueprintType)
+enum class EEnemyStimulusType : uint8
+{
+	None,
+	Sight,
+	Hearing,	// Shots (UEnemyPerceptionSubsystem::ReportNoise)
+	Damage,		// Hit by the target
+};
+
+/**
+ * UEnemyPerceptionComponent: What an enemy knows about its target.
+ * Sight: the nearest player in range (UTargetingSubsystem), inside the view cone while unaware, visible according to
+ * the cached LOS service. Hearing and damage stimuli reveal the source wherever it is.
+ * The last known location is remembered and the memory ages out after MemoryDuration without a new stimulus,
+ * so an enemy keeps hunting for a while after losing sight instead of forgetting the player right away.
+ * Not ticked: UEnemyPerceptionSubsystem updates every component within a per-frame budget.
+ */
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class ROBOQUEST_API UEnemyPerceptionComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:	
+	UEnemyPerceptionComponent();
+
+	// --- Config ---
+
+	// Sight distance, set from the owner's DetectRange when it registers its AI services
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Perception")
+	float SightRange = 1500.0f;
+
+	// Half angle of the view cone while unaware (degrees). Aware enemies track their target all around.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Perception", meta = (ClampMin = "0.0", ClampMax = "180.0"))
+	float SightHalfAngle = 70.0f;
+
+	// Players closer than this are noticed even behind the enemy
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Perception")
+	float ProximityRange = 300.0f;
+
+	// Shots are heard up to this far (scaled by the loudness of the noise)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Perception")
+	float HearingRange = 2500.0f;
+
+	// Seconds the target is remembered after the last stimulus
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Perception")
+	float MemoryDuration = 8.0f;
+
+	// Eye position relative to the actor location, for the LOS test
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Perception")
+	FVector EyeOffset = FVector(0.0f, 0.0f, 50.0f);
+
+	// --- Queries ---
+
+	// Remembered target (nullptr when none, or forgotten)
+	UFUNCTION(BlueprintCallable, Category = "Perception")
+	AActor* GetTarget() const { return Target.Get(); }
+
+	// Was the target in sight at the last update?
+	UFUNCTION(BlueprintCallable, Category = "Perception")
+	bool CanSeeTarget() const { return bTargetVisible && Target.IsValid(); }
+
+	// Where the target was when last sensed
+	UFUNCTION(BlueprintCallable, Category = "Perception")
+	FVector GetLastKnownLocation() const { return LastKnownLocation; }
+
+	UFUNCTION(BlueprintCallable, Category = "Perception")
+	EEnemyStimulusType GetLastStimulusType() const { return LastStimulusType; }
+
+	// 1 right after a stimulus, fading to 0 when the target is forgotten
+	UFUNCTION(BlueprintCallable, Category = "Perception")
+	float GetAwareness() const;
+
+	// --- Stimuli ---
+
+	// Source was sensed at Location (hearing, damage). Ignored when it is not a player.
+	void ReportStimulus(AActor* Source, const FVector& Location, EEnemyStimulusType Type);
+
+	// Sight test and memory aging (called by UEnemyPerceptionSubsystem)
+	void UpdatePerception();
+
+	// Drops the target and every memory of it (death, pooling)
+	void ForgetTarget();
+
+private:
+	// Is Location inside the view cone (or within ProximityRange)?
+	bool IsInSightCone(const FVector& Location) const;
+
+	void Sense(AActor* Source, const FVector& Location, EEnemyStimulusType Type);
+
+	TWeakObjectPtr<AActor> Target;
+	FVector LastKnownLocation = FVector::ZeroVector;
+	EEnemyStimulusType LastStimulusType = EEnemyStimulusType::None;
+	double LastSensedTime = 0.0;
+	bool bTargetVisible = false;
+};
@@ -96,6 +96,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Status")
 	void Heal(float HealAmount);
 
+	// Back to full health (e.g. a pooled enemy being reused)
+	UFUNCTION(BlueprintCallable, Category = "Status")
+	void ResetHealth();
+
+	// Sets health directly, clamped to MaxHealth (e.g. an enemy carrying over damage from its swarm entity)
+	UFUNCTION(BlueprintCallable, Category = "Status")
+	void SetCurrentHealth(float NewHealth);
+
 	// calculated as 1.0 + (CurrentLevel - 1) * DamageMultiplierPerLevel
 	UFUNCTION(BlueprintPure, Category = "Status")
 	float GetDamageMultiplier() const;
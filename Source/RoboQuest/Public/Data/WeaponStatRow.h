@@ -66,6 +66,14 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	float CritDamage = 1.5f;
 
+	// Spread cone half-angle in degrees applied to each bullet (0 = perfectly accurate)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float SpreadAngle = 0.0f;
+
+	// Resolve shots with instant line traces instead of projectiles (meant for high rate-of-fire Precision rows)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bHitscan = false;
+
 	// Ammo Type (Enum)
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	EAmmoType AmmoType = EAmmoType::Magazine;
@@ -23,7 +23,6 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
-	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
 	// --- Combat Stats ---
@@ -65,21 +64,21 @@ public:
 	// Override to handle hit reactions
 	virtual float TakeDamage(float DamageAmount, struct FDamageEvent const& DamageEvent, class AController* EventInstigator, AActor* DamageCauser) override;
 
-private:
-	// Timer for the periodical firing loop
-	FTimerHandle FireLoopTimerHandle;
+	// Drops any attack sequence left over from the previous life
+	virtual void ResetForReuse(const FVector& Location, const FRotator& Rotation) override;
 
-	// Timer for the delay between PreShoot and Shoot
-	FTimerHandle AttackSequenceTimerHandle;
+	// Fire cadence for UEnemyAttackSchedulerSubsystem (FireRate)
+	virtual float GetAttackInterval() const override { return FireRate; }
 
+private:
 	// Prevent spamming attacks or overlapping sequences
 	bool bIsAttacking = false;
 
 	// 1. Check conditions and start the attack sequence (Plays PreShoot)
-	void TryFire();
+	virtual float TryBeginAttack() override;
 
 	// 2. Called after PreShoot finishes. Plays Shoot anim and fires projectile.
-	void PerformShoot();
+	virtual void PerformShoot() override;
 
 	// Spawn the actual projectile
 	void FireProjectile();
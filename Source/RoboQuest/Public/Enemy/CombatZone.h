@@ -5,13 +5,17 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "Enemy/EnemySpawnPoint.h"
+#include "Engine/StreamableManager.h"
 #include "CombatZone.generated.h"
 
 class UBoxComponent;
 
 /**
  * Manages a combat area.
- * Triggers enemy spawns immediately when the player enters the volume.
+ * Queues enemy spawns when the player enters the volume (see UEnemySpawnSchedulerSubsystem).
+ * Spawn points are grouped into timed waves by their WaveIndex.
+ * A larger prefetch volume streams the enemy classes in asynchronously as the player approaches,
+ * so activation never waits on disk. Activation is deferred until the prefetch is done.
  */
 UCLASS()
 class ROBOQUEST_API ACombatZone : public AActor
@@ -21,24 +25,58 @@ class ROBOQUEST_API ACombatZone : public AActor
 public:	
 	ACombatZone();
 
+    // Has the player triggered this zone? Enemies of inactive zones sleep.
+    UFUNCTION(BlueprintCallable, Category = "Combat Settings")
+    bool IsZoneActive() const { return bIsActive; }
+
 protected:
     // Trigger volume to activate the combat zone
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
     UBoxComponent* TriggerBox;
 
+    // Outer volume: entering it starts streaming the enemies of this zone in
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+    UBoxComponent* PrefetchBox;
+
     // List of spawn points linked to this zone
     UPROPERTY(EditInstanceOnly, BlueprintReadWrite, Category = "Combat Settings")
     TArray<AEnemySpawnPoint*> SpawnPoints;
 
+    // Seconds between two waves (wave N spawns N * WaveInterval after activation)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat Settings", meta = (ClampMin = "0.0"))
+    float WaveInterval = 5.0f;
+
     // Has this zone already been triggered?
     bool bIsActive;
 
+    // Triggered while the prefetch was still running: activate as soon as it completes
+    bool bActivationPending = false;
+
+    bool bPrefetchStarted = false;
+    bool bPrefetchComplete = false;
+
+    // Keeps the prefetched classes (and their meshes, montages, projectiles...) resident while the zone exists
+    TSharedPtr<FStreamableHandle> PrefetchHandle;
+
+    // FPlatformTime::Seconds() when the prefetch started
+    double PrefetchStartTime = 0.0;
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
     UFUNCTION()
     void OnOverlapBegin(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
 
-    // Spawns all enemies for this zone instantly
+    UFUNCTION()
+    void OnPrefetchOverlapBegin(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+
+    // Starts streaming the enemy classes of every spawn point in (does nothing if already started)
+    void StartPrefetch();
+
+    // Streaming finished: pre-warm the enemy pool and run a pending activation
+    void OnPrefetchComplete();
+
+    // Queues the enemies of every spawn point of this zone
     void ActivateZone();
 };
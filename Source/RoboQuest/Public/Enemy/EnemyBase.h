@@ -9,6 +9,7 @@
 #include "EnemyBase.generated.h"
 
 class AHealingCell;
+class ACombatZone;
 
 UCLASS()
 class ROBOQUEST_API AEnemyBase : public ACharacter
@@ -22,9 +23,21 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
 	class UStatusComponent* StatusComponent;
 
+	// Sight / hearing / damage memory of the target, updated by UEnemyPerceptionSubsystem
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+	class UEnemyPerceptionComponent* PerceptionComponent;
+
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// Subscribes this enemy to the shared AI services: UTargetingSubsystem, UEnemyPerceptionSubsystem,
+	// UEnemySignificanceSubsystem and UEnemyAttackSchedulerSubsystem (derived classes pass their DetectRange)
+	void RegisterAIServices(float DetectRange);
+
+	// Undoes RegisterAIServices (on death and EndPlay)
+	void UnregisterAIServices();
 
 	//UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Enemy|Components")
 	//UEnemyHealthComponent* Health;
@@ -54,6 +67,41 @@ protected:
 	UPROPERTY(EditAnywhere, BluePrintReadWrite, Category = "Drops")
 	int32 DropCount = 3;
 
+	// How long the ragdoll stays before the enemy goes back to its pool (or is destroyed)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Death")
+	float CorpseLifeSpan = 5.0f;
+
+	// Played instead of the ragdoll when UCorpseManagerSubsystem has no ragdoll slot left. Author it without auto
+	// blend out: the mesh freezes on its last pose. Without one, such corpses fall as a cheap ragdoll instead.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Death")
+	class UAnimMontage* DeathMontage;
+
+	// Seconds a cheap ragdoll (no ragdoll slot and no DeathMontage) simulates before it is put to sleep
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Death")
+	float CheapRagdollSleepTime = 1.0f;
+
+	// Below this speed (cm/s) for two checks in a row, the ragdoll is put to sleep and the mesh stops updating
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Death")
+	float RagdollSleepSpeed = 10.0f;
+
+	// Seconds between two ragdoll settle checks
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Death")
+	float RagdollSettleCheckInterval = 0.25f;
+
+public:
+	// Mesh drawn (instanced) while this enemy is a distant swarm entity instead of an actor (see USwarmSubsystem)
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Swarm")
+	class UStaticMesh* SwarmProxyMesh;
+
+	// Scale of the swarm proxy instances
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Swarm")
+	FVector SwarmProxyScale = FVector::OneVector;
+
+	// Combat zone this enemy belongs to. While the zone is inactive the enemy sleeps (see UEnemySignificanceSubsystem).
+	// Set by the zone for spawned enemies, or by hand for enemies placed in the level.
+	UPROPERTY(EditInstanceOnly, BlueprintReadWrite, Category = "AI")
+	ACombatZone* OwningZone = nullptr;
+
 public:	
 	virtual float TakeDamage(float DamageAmount, struct FDamageEvent const& DamageEvent, class AController* EventInstigator, AActor* DamageCauser) override;
 
@@ -62,11 +110,84 @@ public:
 	UFUNCTION(BlueprintCallable)
 	bool IsAlive() const { return !bIsDead; }
 
+	// Where the perceived target is: its real location while in sight, otherwise where it was last seen, heard or
+	// hit us from. Movement and facing use this, so an enemy never tracks a hidden player through walls.
+	FVector GetPerceivedTargetLocation() const;
+
+	// --- Pooling (see UEnemyPoolSubsystem) ---
+
+	// Called by the pool right after spawning this enemy
+	void MarkAsPooled() { bIsPooled = true; }
+
+	// Was this enemy created by the enemy pool?
+	bool IsPooled() const { return bIsPooled; }
+
+	// Parks the enemy in its pool: hidden, no collision, no ticking, no AI services.
+	// Parked enemies count as dead, so their timers (fire loops...) do nothing.
+	virtual void DeactivatePooledEnemy();
+
+	// Brings a parked (or dead) enemy back to its spawn state at the given transform:
+	// health, collision, mesh (ragdoll off), movement, AI controller and AI services.
+	virtual void ResetForReuse(const FVector& Location, const FRotator& Rotation);
+
+	// --- Attacks (driven by UEnemyAttackSchedulerSubsystem) ---
+
+	// Seconds between two attack attempts (0 = this enemy does not attack)
+	virtual float GetAttackInterval() const { return 0.0f; }
+
+	// Starts an attack if possible. Returns the telegraph (PreShoot) duration, 0 to shoot right away,
+	// or a negative value if the enemy can't attack right now.
+	virtual float TryBeginAttack() { return -1.0f; }
+
+	// End of the telegraph: actually shoot
+	virtual void PerformShoot() {}
+
+	// Ends the corpse window now: back to the pool or destroyed (used by UCorpseManagerSubsystem)
+	void RetireCorpse();
+
+	// Possesses this enemy with a new AIControllerClass controller if it has none (and auto-possesses when spawned)
+	void EnsureController();
+
 protected:
+	// End of the ragdoll window: back to the pool instead of being destroyed
+	virtual void LifeSpanExpired() override;
+
 	// bind to health changed event
 	UFUNCTION()
 	void OnHealthChanged(float CurrentHealth, float ScratchHealth, float MaxHealth);
 
 	// Spawns healing cells
 	virtual void SpawnDrops();
+
+	// Death with a ragdoll slot: physics on, settle checks started
+	void StartRagdoll();
+
+	// Death without one: DeathMontage, then the pose is frozen (cheap ragdoll without a montage)
+	void PlayDeathMontage();
+
+	// Ragdoll outside the simulation budget: only collides with the level, put to sleep after CheapRagdollSleepTime
+	void StartCheapRagdoll();
+
+	// Puts the ragdoll to sleep once it stopped moving (timer started by StartRagdoll)
+	void CheckRagdollSettled();
+
+	// Stops the mesh at the end of the death montage (or of the cheap ragdoll)
+	void FreezeCorpsePose();
+
+private:
+	// Created by UEnemyPoolSubsystem
+	bool bIsPooled = false;
+
+	// Range given to RegisterAIServices, reused when the enemy is recycled
+	float RegisteredDetectRange = 0.0f;
+
+	FTimerHandle CorpseTimer;
+
+	// Consecutive settle checks that found the ragdoll still
+	int32 RagdollStillChecks = 0;
+
+	// Spawn state of the components that dying changes (restored by ResetForReuse)
+	FTransform DefaultMeshRelativeTransform;
+	FName DefaultMeshCollisionProfile;
+	ECollisionEnabled::Type DefaultCapsuleCollision = ECollisionEnabled::QueryAndPhysics;
 };
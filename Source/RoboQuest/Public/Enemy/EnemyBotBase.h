@@ -61,11 +61,7 @@ protected:
 	// Find nearest player
 	virtual void FindTarget();
 
-	// Tank-like rotation: Rotate Actor to face Target
-	virtual void RotateTowardsTarget(float DeltaTime);
 
-	// Tank-like movement: Move Forward/Backward only
-	virtual void MoveTowardsTarget(float DeltaTime);
 
 	// Check if we have a live target
 	bool HasValidTarget() const;
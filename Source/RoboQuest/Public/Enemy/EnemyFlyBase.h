@@ -61,6 +61,35 @@ public:
 	UPROPERTY(EditAnywhere, Category = "AI|Movement")
 	float PreferredMaxRange = 1200.0f;
 
+	// --- Flocking Settings (see UFlockingSubsystem) ---
+	// If true, the enemy keeps its distance from (and moves with) nearby flying enemies
+	UPROPERTY(EditAnywhere, Category = "AI|Movement")
+	bool bEnableFlocking = true;
+
+	// Strength of the flocking force, relative to the hover direction
+	UPROPERTY(EditAnywhere, Category = "AI|Movement")
+	float FlockingWeight = 1.0f;
+
+	// --- Flight Path Settings (see UFlightNavigationSubsystem) ---
+	// If true, the enemy flies around the geometry along a path when it loses sight of its target
+	UPROPERTY(EditAnywhere, Category = "AI|Movement")
+	bool bUseFlightPaths = true;
+
+	// Minimum time between two path requests
+	UPROPERTY(EditAnywhere, Category = "AI|Movement")
+	float RepathInterval = 1.0f;
+
+	// Replan when the target moved this far from the end of the path
+	UPROPERTY(EditAnywhere, Category = "AI|Movement")
+	float RepathDistance = 500.0f;
+
+	// Distance at which a waypoint counts as reached
+	UPROPERTY(EditAnywhere, Category = "AI|Movement")
+	float WaypointAcceptanceRadius = 150.0f;
+
+	// Drops the flight path of the previous life
+	virtual void ResetForReuse(const FVector& Location, const FRotator& Rotation) override;
+
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
@@ -81,8 +110,6 @@ protected:
 	// Logic to find a target (Player)
 	virtual void FindTarget();
 
-	// Logic to rotate towards the current target
-	virtual void RotateTowardsTarget(float DeltaTime);
 
 	// Checks if the target is valid and exists
 	UFUNCTION(BlueprintCallable, Category = "AI")
@@ -94,9 +121,31 @@ protected:
 
     // --- New Function ---
     // Calculates a vector to steer away from obstacles (Ground & Walls)
+    // Samples the level's distance field (AOccupancyGridVolume) when there is one, and only traces
+    // outside of it or near movable obstacles
     UFUNCTION(BlueprintCallable, Category = "AI|Movement")
     FVector CalculateObstacleAvoidance();
 
+	// Same rules as the traces, read from a precomputed distance field (no physics query)
+	FVector CalculateFieldAvoidance(const class AOccupancyGridVolume& Grid, const FVector& MoveDir) const;
+
 	// Calculates a new random direction for intelligent hovering
 	virtual void PickNewHoverDirection();
+
+	// Follows (and requests) a flight path while the target is out of sight.
+	// Returns false when there is no path to follow (target visible, no grid or path pending): hover instead.
+	bool UpdateFlightPath(bool bCanSeeTarget, FVector& OutDirection);
+
+	// Asks UFlightNavigationSubsystem for a path to Goal; the result arrives asynchronously
+	void RequestFlightPath(const FVector& Goal);
+
+	// Waypoints to fly through (the last one is next to the target)
+	TArray<FVector> FlightPath;
+	int32 FlightPathIndex = 0;
+
+	float LastPathRequestTime = -1000.0f;
+	bool bPathRequestPending = false;
+
+	// Bumped on every request and on reuse, so late answers to an old request are ignored
+	int32 PathRequestSerial = 0;
 };
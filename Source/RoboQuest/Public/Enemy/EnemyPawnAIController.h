@@ -6,8 +6,25 @@
 #include "AIController.h"
 #include "EnemyPawnAIController.generated.h"
 
+class AEnemyPawnBase;
+
+// What the controller is doing for its pawn
+UENUM(BlueprintType)
+enum class EEnemyPawnAIState : uint8
+{
+	Idle,			// No target (or dead): no movement
+	Approach,		// Target far away: path (or flow field) towards it
+	Engage,			// Target close and visible: the pawn's combat movement takes over
+	Reposition,		// Target close but out of sight: go to where it was last seen, heard or hit us from
+};
+
 /**
- * 
+ * AEnemyPawnAIController: Event-driven controller of the grounded enemies.
+ * Each tick only compares the situation (target, visibility, range band) with the previous one; path requests are
+ * made when the state changes, or when the goal moved more than RepathDistance from the current one.
+ * Goals come from the pawn's perception: the target's location while in sight, otherwise its last known location.
+ * No request at all while the pawn walks along the shared flow field (UFlowFieldSubsystem).
+ * Path requests are counted in "stat RoboQuest" (per frame and per second).
  */
 UCLASS()
 class ROBOQUEST_API AEnemyPawnAIController : public AAIController
@@ -17,7 +34,54 @@ class ROBOQUEST_API AEnemyPawnAIController : public AAIController
 public:
 	AEnemyPawnAIController();
 
+	UFUNCTION(BlueprintCallable, Category = "AI")
+	EEnemyPawnAIState GetAIState() const { return State; }
+
+	// Path requests made by all enemy pawn controllers during the last full second
+	static int32 GetPathRequestsPerSecond();
+
+	// Ask for a new path when the goal moved this far from the one of the current path
+	UPROPERTY(EditAnywhere, Category = "AI")
+	float RepathDistance = 300.0f;
+
+	// Minimum time between two path requests of this controller
+	UPROPERTY(EditAnywhere, Category = "AI")
+	float MinRepathInterval = 0.5f;
+
 protected:
 	virtual void OnPossess(APawn* InPawn) override;
+	virtual void OnUnPossess() override;
 	virtual void Tick(float DeltaTime) override;
+	virtual void OnMoveCompleted(FAIRequestID RequestID, const FPathFollowingResult& Result) override;
+
+	// State the current situation calls for
+	EEnemyPawnAIState EvaluateState(bool bHasTarget, bool bCanSee) const;
+
+	// Transition: the only place (with the repath check) that starts or stops movement
+	void EnterState(EEnemyPawnAIState NewState);
+
+	// Approach / Reposition: keeps the path up to date without re-requesting every tick
+	void UpdateMovement();
+
+	// MoveToLocation, throttled by MinRepathInterval and counted
+	void RequestPathTo(const FVector& Goal, float AcceptanceRadius);
+
+	UPROPERTY(Transient)
+	AEnemyPawnBase* EnemyPawn = nullptr;
+
+	EEnemyPawnAIState State = EEnemyPawnAIState::Idle;
+
+	// --- Last observed situation (changes are the events the controller reacts to) ---
+	TWeakObjectPtr<AActor> LastTarget;
+
+	// Perceived location of the target (see AEnemyBase::GetPerceivedTargetLocation)
+	FVector PerceivedTargetLocation = FVector::ZeroVector;
+
+	// Reached the last known location without regaining sight: approach instead (until a new stimulus elsewhere)
+	bool bRepositionDone = false;
+
+	// Goal of the current path request
+	FVector PathGoal = FVector::ZeroVector;
+	bool bHasPath = false;
+	float LastPathRequestTime = -1000.0f;
 };
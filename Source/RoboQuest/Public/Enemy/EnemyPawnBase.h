@@ -57,6 +57,10 @@ public:
 	// Checks visibility
 	bool CanSeeTarget() const;
 
+	// Is the pawn walking along the shared flow field (UFlowFieldSubsystem) this tick? The AIController then
+	// leaves the approach to it instead of asking the navmesh for a path.
+	bool IsFollowingFlowField() const { return bFollowingFlowField; }
+
 protected:
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
@@ -69,12 +73,6 @@ protected:
 	// Logic to find a target (Player)
 	virtual void FindTarget();
 
-	// Logic to rotate towards the current target (Yaw only)
-	virtual void RotateTowardsTarget(float DeltaTime);
-
-	// Basic movement while in combat: maintain range and strafe
-	virtual void CombatMove(float DeltaTime);
-
 	// Basic direct movement towards target (fallback)
 	virtual void MoveToTarget();
 
@@ -90,4 +88,7 @@ protected:
 
 	// Current strafing direction multiplier (-1 left, 0 none, 1 right)
 	float StrafeDirectionScale = 0.0f;
+
+	// Set every tick, see IsFollowingFlowField
+	bool bFollowingFlowField = false;
 };
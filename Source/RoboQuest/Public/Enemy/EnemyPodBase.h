@@ -31,6 +31,8 @@ public:
 	float RotationSpeed = 5.0f;
 
 protected:
+	virtual void BeginPlay() override;
+
 	// The current target actor
 	UPROPERTY(VisibleInstanceOnly, Category = "AI")
 	AActor* CurrentTarget;
@@ -39,8 +41,6 @@ protected:
 	// Logic to find a target
 	virtual void FindTarget();
 
-	// Logic to rotate towards the current target
-	virtual void RotateTowardsTarget(float DeltaTime);
 
 	// Checks if the target is valid and exists
 	UFUNCTION(BlueprintCallable, Category = "AI")
@@ -21,8 +21,13 @@ public:
 
     // The type of enemy to spawn at this specific point.
     // Can be left empty if the CombatZone controls the enemy type.
+    // Soft reference: the owning CombatZone streams the class (and everything it references) in before activation.
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spawn Settings")
-	TSubclassOf<AEnemyBase> EnemyClassToSpawn;
+	TSoftClassPtr<AEnemyBase> EnemyClassToSpawn;
+
+    // Wave this point belongs to (0 = spawns when the zone activates, see ACombatZone::WaveInterval)
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spawn Settings", meta = (ClampMin = "0"))
+    int32 WaveIndex = 0;
 
     // Helper component to visualize the direction in the editor
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
@@ -31,4 +36,7 @@ public:
 public:
     // Spawns the enemy immediately without any effects
     AEnemyBase* SpawnEnemy();
+
+    // Is EnemyClassToSpawn in memory? (SpawnEnemy would otherwise load it synchronously)
+    bool IsEnemyClassLoaded() const { return EnemyClassToSpawn.IsNull() || EnemyClassToSpawn.Get() != nullptr; }
 };
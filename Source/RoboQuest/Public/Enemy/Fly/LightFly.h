@@ -36,6 +36,12 @@ public:
 	// Override TakeDamage to handle Stagger logic
 	virtual float TakeDamage(float DamageAmount, struct FDamageEvent const& DamageEvent, class AController* EventInstigator, AActor* DamageCauser) override;
 
+	// Drops any attack sequence left over from the previous life
+	virtual void ResetForReuse(const FVector& Location, const FRotator& Rotation) override;
+
+	// Fire cadence for UEnemyAttackSchedulerSubsystem (FireRate)
+	virtual float GetAttackInterval() const override { return FireRate; }
+
 	// --- Combat Stats ---
 
 	// Firing Loop Rate (Seconds)
@@ -73,22 +79,16 @@ public:
 	float HitDamageThreshold = 10.0f;
 
 protected:
-	// Timer for attack loop
-	FTimerHandle FireLoopTimerHandle;
-	
-	// Timer for sequence: PreShoot -> Shoot
-	FTimerHandle AttackSequenceTimerHandle;
-
 	// Track if we are currently in an attack sequence to avoid overlapping
 	bool bIsAttacking = false;
 
 	// --- Combat Functions ---
 
 	// 1. Check conditions and start the attack sequence
-	void TryFire();
+	virtual float TryBeginAttack() override;
 
 	// 2. Called after PreShoot finishes, plays Shoot animation and fires projectile
-	void PerformShoot();
+	virtual void PerformShoot() override;
 
 	// Spawn the actual projectile
 	void FireProjectile();
@@ -22,12 +22,17 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
-	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
 	// Override TakeDamage to handle Stagger logic
 	virtual float TakeDamage(float DamageAmount, struct FDamageEvent const& DamageEvent, class AController* EventInstigator, AActor* DamageCauser) override;
 
+	// Drops any attack sequence left over from the previous life
+	virtual void ResetForReuse(const FVector& Location, const FRotator& Rotation) override;
+
+	// Fire cadence for UEnemyAttackSchedulerSubsystem (FireRate)
+	virtual float GetAttackInterval() const override { return FireRate; }
+
 	// --- Combat Stats ---
 
 	// Firing Loop Rate (Seconds)
@@ -65,22 +70,16 @@ public:
 	float HitDamageThreshold = 20.0f;
 
 protected:
-	// Timer handle for automatic fire loop
-	FTimerHandle FireLoopTimerHandle;
-
-	// Timer handle for the delay between PreShoot and Shoot
-	FTimerHandle AttackSequenceTimerHandle;
-
 	// Track if we are currently in an attack sequence
 	bool bIsAttacking = false;
 
 	// --- Combat Functions ---
 
 	// Check conditions and start the attack sequence
-	void TryFire();
+	virtual float TryBeginAttack() override;
 
 	// Called after PreShoot finishes, play Shoot animation and fire projectile
-	void PerformShoot();
+	virtual void PerformShoot() override;
 
 	// Spawn the actual projectile
 	void FireProjectile();
@@ -23,9 +23,6 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
-	// Called when the game ends or actor is destroyed
-	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
-
 public:
 	// --- Combat Stats ---
 	
@@ -67,21 +64,21 @@ public:
 	// Override TakeDamage to handle Stagger logic
 	virtual float TakeDamage(float DamageAmount, struct FDamageEvent const& DamageEvent, class AController* EventInstigator, AActor* DamageCauser) override;
 
-protected:
-	// Timer handle for automatic fire loop (periodical)
-	FTimerHandle FireLoopTimerHandle;
+	// Drops any attack sequence left over from the previous life
+	virtual void ResetForReuse(const FVector& Location, const FRotator& Rotation) override;
 
-	// Timer handle for the delay between PreShoot and Shoot
-	FTimerHandle AttackSequenceTimerHandle;
+	// Fire cadence for UEnemyAttackSchedulerSubsystem (FireRate)
+	virtual float GetAttackInterval() const override { return FireRate; }
 
+protected:
 	// Track if we are currently in an attack sequence to avoid overlapping
 	bool bIsAttacking = false;
 
 	// 1. Check conditions and start the attack sequence
-	void TryFire();
+	virtual float TryBeginAttack() override;
 
 	// 2. Called after PreShoot finishes, plays Shoot animation and fires projectile
-	void PerformShoot();
+	virtual void PerformShoot() override;
 
 	// Spawn the actual projectile
 	void FireProjectile();
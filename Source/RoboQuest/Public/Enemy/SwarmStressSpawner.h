@@ -0,0 +1,40 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "SwarmStressSpawner.generated.h"
+
+class AEnemyBase;
+
+/**
+ * Drop into a test map to fill it with swarm entities (see USwarmSubsystem), e.g. 1,000 LightFlies.
+ * Entities are scattered in a disc around this actor. Use "stat RoboQuest" and "stat unit" to watch the cost.
+ */
+UCLASS()
+class ROBOQUEST_API ASwarmStressSpawner : public AActor
+{
+	GENERATED_BODY()
+	
+public:	
+	ASwarmStressSpawner();
+
+	// Enemy type of the swarm (needs a SwarmProxyMesh to be visible)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Swarm")
+	TSubclassOf<AEnemyBase> EnemyClass;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Swarm", meta = (ClampMin = "0"))
+	int32 Count = 1000;
+
+	// Radius of the disc the entities are scattered in
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Swarm")
+	float Radius = 8000.0f;
+
+	// Random height above this actor
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Swarm")
+	FVector2D HeightRange = FVector2D(200.0f, 800.0f);
+
+protected:
+	virtual void BeginPlay() override;
+};
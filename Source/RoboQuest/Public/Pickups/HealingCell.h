@@ -6,6 +6,12 @@
 #include "GameFramework/Actor.h"
 #include "HealingCell.generated.h"
 
+/**
+ * AHealingCell: Health dropped by enemies.
+ * The actor only lives for its physics "pop" on spawn. Once it has settled (or a player comes within magnet range)
+ * it hands itself over to UPickupSubsystem, which homes and collects every cell in one batched update and draws
+ * them with a single instanced mesh.
+ */
 UCLASS()
 class ROBOQUEST_API AHealingCell : public AActor
 {
@@ -13,10 +19,22 @@ class ROBOQUEST_API AHealingCell : public AActor
 	
 public:	
 	AHealingCell();
-	virtual void Tick(float DeltaTime) override;
+
+	// Heals Collector if it is the player character. Returns false (nothing consumed) otherwise.
+	static bool HealCollector(AActor* Collector, float HealAmount);
+
+	// Another drop merged into this one (see UPickupSubsystem::MergeDrop)
+	void AddToStack(float InHealAmount, int32 InStackCount);
+
+	float GetHealAmount() const { return HealAmount; }
+	int32 GetStackCount() const { return StackCount; }
+
+	// World time of the spawn
+	float GetSpawnTime() const { return SpawnTime; }
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	// --- Components ---
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
@@ -42,13 +60,23 @@ protected:
 	UPROPERTY(EditAnywhere, Category = "Healing")
 	float SpawnImpulseStrength = 150.0f;
 
+	// The pop ends when the body sleeps, or after this long at most
+	UPROPERTY(EditAnywhere, Category = "Healing")
+	float MaxPopDuration = 2.0f;
+
 private:
-	// State
-	bool bIsMagnetized = false;
 	// Prevent double consumption
 	bool bIsConsumed = false;
 
-	AActor* TargetPlayer = nullptr;
+	// Drops merged into this cell (HealAmount is their sum)
+	int32 StackCount = 1;
+
+	float SpawnTime = 0.0f;
+
+	FTimerHandle HandOffTimer;
+
+	// Hands the cell over to UPickupSubsystem once the pop is over
+	void CheckPopFinished();
 
 	UFUNCTION()
 	void OnOverlapBegin(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
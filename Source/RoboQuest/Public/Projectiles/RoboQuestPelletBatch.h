@@ -0,0 +1,122 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "RoboQuestPelletBatch.generated.h"
+
+class UInstancedStaticMeshComponent;
+
+// State of a single pellet inside a batch (plain data, no components)
+struct FRoboQuestPellet
+{
+	FVector Location = FVector::ZeroVector;
+	FVector Velocity = FVector::ZeroVector;
+	// Distance travelled so far in cm, checked against the batch range
+	float TravelledDistance = 0.0f;
+	bool bAlive = false;
+};
+
+/**
+ * ARoboQuestPelletBatch: Simulates every pellet of a multi-bullet shot (BulletCount > 1) inside one actor.
+ * Pellets are swept once per frame in a single loop and rendered through one instanced static mesh,
+ * instead of paying for an ARoboQuestProjectile (collision + movement component) per pellet.
+ * Damage goes through ARoboQuestProjectile::ApplyProjectileDamage, the same path as regular projectiles.
+ */
+UCLASS(config=Game)
+class ROBOQUEST_API ARoboQuestPelletBatch : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ARoboQuestPelletBatch();
+
+	virtual void Tick(float DeltaTime) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// Launches one pellet per direction from Origin. Each pellet retires after NewRange meters
+	// (falls back to InitialLifeSpan when NewRange <= 0).
+	void InitializePellets(const FVector& Origin, const TArray<FVector>& Directions, float NewDamage, float NewRange, float NewCritMul);
+
+	// --- Pooling (see UProjectilePoolSubsystem) ---
+
+	// Called by the pool right after spawning this batch
+	void MarkAsPooled() { bIsPooled = true; }
+
+	// Was this batch created by the projectile pool?
+	bool IsPooled() const { return bIsPooled; }
+
+	// Is this batch currently simulating a shot (false while parked in the pool)
+	bool IsInFlight() const { return bIsInFlight; }
+
+	// Moves the batch to the given transform and re-enables tick and visibility
+	void ActivatePooledBatch(const FVector& Location, const FRotator& Rotation);
+
+	// Hides the batch, clears its pellets and stops ticking until it is acquired again
+	void DeactivatePooledBatch();
+
+	// Ends this shot: retires the pellets still flying, then returns the batch to its pool (or destroys it)
+	void RetireBatch();
+
+	// --- Config ---
+	// Speed of every pellet (matches the default projectile speed)
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Pellets")
+	float PelletSpeed = 3000.0f;
+
+	// Radius of the sphere swept for each pellet
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Pellets")
+	float PelletRadius = 5.0f;
+
+	// Scale applied to world gravity (projectiles fall with 1.0 by default)
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Pellets")
+	float GravityScale = 1.0f;
+
+	// Collision profile used for the sweeps (same as ARoboQuestProjectile)
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Pellets")
+	FName CollisionProfileName = TEXT("Projectile");
+
+	// Scale of each rendered pellet instance
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Pellets")
+	FVector PelletMeshScale = FVector(1.0f);
+
+	// Damage dealt by each pellet
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Pellets")
+	float Damage;
+
+	// Effective range in meters
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Pellets")
+	float RangeMeter;
+
+	// Critical damage multiplier
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Pellets")
+	float CritDamageMultiplier;
+
+protected:
+	// One instance per pellet
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+	UInstancedStaticMeshComponent* PelletMeshes;
+
+	// Pushes pellet positions to the instanced mesh
+	void UpdatePelletInstances();
+
+	// Marks a pellet dead and updates the projectile stats
+	void RetirePellet(FRoboQuestPellet& Pellet);
+
+	// Return to the pool instead of being destroyed when the lifespan runs out
+	virtual void LifeSpanExpired() override;
+
+private:
+	TArray<FRoboQuestPellet> Pellets;
+
+	int32 NumAlivePellets = 0;
+
+	// Range budget of every pellet in cm (0 = unlimited)
+	float MaxTravelDistance = 0.0f;
+
+	// Created by UProjectilePoolSubsystem
+	bool bIsPooled = false;
+
+	// False while the batch is parked in the pool
+	bool bIsInFlight = true;
+};
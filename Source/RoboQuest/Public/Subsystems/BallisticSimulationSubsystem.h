@@ -0,0 +1,80 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "BallisticSimulationSubsystem.generated.h"
+
+class ARoboQuestProjectile;
+
+/**
+ * UBallisticSimulationSubsystem: Owns every in-flight bullet of projectile classes flagged bSimulateCentrally.
+ * Bullet state lives in structure-of-arrays buffers that are advanced in one pass per frame, so there is no
+ * per-bullet actor tick. Each step is swept with an async query issued at the end of the pass and resolved at
+ * the start of the next one. A pooled ARoboQuestProjectile can follow each bullet as a pure visual proxy.
+ * Classes that are not flagged fall back to pooled actors (UProjectilePoolSubsystem), so every shooter can go
+ * through FireProjectile().
+ */
+UCLASS()
+class ROBOQUEST_API UBallisticSimulationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Fires one shot of the given projectile class (simulated centrally or as a pooled actor)
+	void FireProjectile(TSubclassOf<ARoboQuestProjectile> ProjectileClass, const FVector& Location, const FRotator& Rotation, AActor* Shooter, APawn* ShooterInstigator, float Damage, float RangeMeter, float CritMul);
+
+	// Number of bullets currently simulated
+	UFUNCTION(BlueprintCallable, Category = "Ballistics")
+	int32 GetNumSimulatedProjectiles() const { return Positions.Num(); }
+
+	// Initial capacity of the simulation buffers
+	UPROPERTY(EditAnywhere, Category = "Ballistics")
+	int32 InitialCapacity = 5120;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	// Removes bullet Index from every buffer (swap with the last one)
+	void RemoveProjectileAt(int32 Index);
+
+	// Issues the async sweep of bullet Index from Positions to SweepEnds
+	void RequestSweep(UWorld* World, int32 Index);
+
+	// Returns the blocking hit of bullet Index's pending sweep. Falls back to a synchronous sweep when the
+	// async result is not available (e.g. the request missed this frame's batch)
+	bool ResolveSweep(UWorld* World, int32 Index, FHitResult& OutHit);
+
+	// Query params shared by every sweep of bullet Index
+	FCollisionQueryParams MakeQueryParams(int32 Index) const;
+
+	// --- Structure of arrays, one entry per bullet ---
+	TArray<FVector> Positions;
+	TArray<FVector> Velocities;
+	// Remaining travel distance in cm (from RangeMeter, unlimited without range)
+	TArray<float> RemainingRange;
+	// Remaining lifetime in seconds (class InitialLifeSpan, only used for shots without range)
+	TArray<float> RemainingLife;
+	TArray<float> Damages;
+	TArray<float> CritMultipliers;
+	TArray<float> GravityZ;
+	TArray<float> Radii;
+	TArray<FName> CollisionProfiles;
+	TArray<TWeakObjectPtr<AActor>> Owners;
+	TArray<TWeakObjectPtr<APawn>> Instigators;
+	TArray<TWeakObjectPtr<ARoboQuestProjectile>> VisualProxies;
+	// End of the step currently being swept (Positions is its start)
+	TArray<FVector> SweepEnds;
+	// Async sweep of that step, invalid until the bullet has been integrated once
+	TArray<FTraceHandle> PendingSweeps;
+
+	// Scratch buffer reused every frame
+	TArray<uint8> RetireFlags;
+};
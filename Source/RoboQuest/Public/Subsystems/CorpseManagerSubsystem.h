@@ -0,0 +1,57 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CorpseManagerSubsystem.generated.h"
+
+class AEnemyBase;
+
+/**
+ * UCorpseManagerSubsystem: Budget for dead enemies.
+ * At most MaxSimulatedRagdolls corpses simulate physics at once; enemies dying beyond that play their baked
+ * DeathMontage instead, or fall as a cheap level-only ragdoll that sleeps after a fixed time (see AEnemyBase::Die).
+ * A ragdoll gives its slot back once it settles and sleeps.
+ * At most MaxCorpses corpses are kept: the oldest one is recycled (back to its pool or destroyed) to make room.
+ */
+UCLASS(config=Game)
+class ROBOQUEST_API UCorpseManagerSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// Adds a fresh corpse (recycling the oldest one if needed). Returns whether it may simulate a ragdoll.
+	bool RegisterCorpse(AEnemyBase* Enemy);
+
+	// The ragdoll of Enemy went to sleep: its slot is free for the next death
+	void OnRagdollSettled(AEnemyBase* Enemy);
+
+	// Enemy is recycled, destroyed or alive again
+	void UnregisterCorpse(AEnemyBase* Enemy);
+
+	UFUNCTION(BlueprintCallable, Category = "Corpses")
+	int32 GetNumSimulatedRagdolls() const;
+
+	// Ragdolls simulating at the same time
+	UPROPERTY(Config, EditAnywhere, Category = "Corpses")
+	int32 MaxSimulatedRagdolls = 8;
+
+	// Corpses kept at the same time (ragdolls and montages)
+	UPROPERTY(Config, EditAnywhere, Category = "Corpses")
+	int32 MaxCorpses = 24;
+
+private:
+	struct FCorpseEntry
+	{
+		TWeakObjectPtr<AEnemyBase> Enemy;
+		bool bSimulating = false;
+	};
+
+	void UpdateStats() const;
+
+	// Oldest first
+	TArray<FCorpseEntry> Corpses;
+};
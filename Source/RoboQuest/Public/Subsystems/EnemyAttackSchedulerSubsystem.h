@@ -0,0 +1,72 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyAttackSchedulerSubsystem.generated.h"
+
+class AEnemyBase;
+
+/**
+ * UEnemyAttackSchedulerSubsystem: Drives the fire cadence of every attacking enemy from one flat array,
+ * instead of a looping timer plus a telegraph timer per enemy in the global timer manager.
+ * Each frame, the enemies whose attack is due are bucketed (longest waiting first) and asked to start an attack
+ * (AEnemyBase::TryBeginAttack). The telegraph (PreShoot) is then timed here and followed by AEnemyBase::PerformShoot.
+ * At most MaxConcurrentTelegraphs telegraphs run at once and at most MaxAttackStartsPerFrame attacks start per frame;
+ * attacks held back by a cap simply retry on the next frame.
+ */
+UCLASS()
+class ROBOQUEST_API UEnemyAttackSchedulerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Starts attacking every AttackInterval seconds (first attempt after a random fraction of it, to desync enemies)
+	void RegisterAttacker(AEnemyBase* Enemy, float AttackInterval);
+
+	// Stops attacking and cancels a running telegraph
+	void UnregisterAttacker(AEnemyBase* Enemy);
+
+	// Cancels the running telegraph of Enemy (e.g. staggered), its cadence goes on
+	void CancelTelegraph(AEnemyBase* Enemy);
+
+	// Number of telegraphs currently running
+	UFUNCTION(BlueprintCallable, Category = "Attack Scheduler")
+	int32 GetNumActiveTelegraphs() const { return NumActiveTelegraphs; }
+
+	// Global cap on enemies telegraphing (winding up) at the same time
+	UPROPERTY(EditAnywhere, Category = "Attack Scheduler")
+	int32 MaxConcurrentTelegraphs = 6;
+
+	// Cap on attacks started per frame, to smooth out CPU spikes when many cadences line up
+	UPROPERTY(EditAnywhere, Category = "Attack Scheduler")
+	int32 MaxAttackStartsPerFrame = 8;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FAttackEntry
+	{
+		TWeakObjectPtr<AEnemyBase> Enemy;
+		double NextAttackTime = 0.0;
+		double ShootTime = 0.0;
+		float AttackInterval = 0.0f;
+		bool bTelegraphing = false;
+	};
+
+	FAttackEntry* FindEntry(const AEnemyBase* Enemy);
+
+	TArray<FAttackEntry> Entries;
+
+	// Scratch buckets, kept to avoid reallocating every frame
+	TArray<int32> DueAttacks;
+	TArray<TWeakObjectPtr<AEnemyBase>> DueShots;
+
+	int32 NumActiveTelegraphs = 0;
+};
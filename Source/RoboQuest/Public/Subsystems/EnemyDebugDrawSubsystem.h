@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Components/LineBatchComponent.h"
+#include "EnemyDebugDrawSubsystem.generated.h"
+
+// Debug visualization channels, each toggled by its own console variable
+enum class EEnemyDebugCategory : uint8
+{
+	LOS,		// rq.Debug.LOS: enemy -> target visibility lines
+	Avoidance,	// rq.Debug.Avoidance: flying enemy ground/wall probes
+	Hover,		// rq.Debug.Hover: flying enemy hover direction
+	Strafe,		// rq.Debug.Strafe: grounded enemy combat move direction
+};
+
+/**
+ * UEnemyDebugDrawSubsystem: Collects enemy debug lines for the enabled categories only and submits them to the
+ * world line batcher in one call per frame. Every category is off by default, so nothing is recorded unless
+ * a console toggle is on. Call sites are wrapped in ENABLE_DRAW_DEBUG, so the lines compile out of Shipping.
+ */
+UCLASS()
+class ROBOQUEST_API UEnemyDebugDrawSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Is the console toggle of this category on? (always false when debug drawing is compiled out)
+	static bool IsCategoryEnabled(EEnemyDebugCategory Category);
+
+	// Records a one-frame line in the world of WorldContextObject if Category is enabled
+	static void DrawLine(const UObject* WorldContextObject, EEnemyDebugCategory Category, const FVector& Start, const FVector& End, const FColor& Color, float Thickness = 0.0f);
+
+	// Records a one-frame line if Category is enabled
+	void AddLine(EEnemyDebugCategory Category, const FVector& Start, const FVector& End, const FColor& Color, float Thickness = 0.0f);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	// Lines recorded this frame, flushed in Tick
+	TArray<FBatchedLine> PendingLines;
+};
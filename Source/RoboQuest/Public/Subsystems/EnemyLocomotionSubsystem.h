@@ -0,0 +1,139 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "EnemyLocomotionSubsystem.generated.h"
+
+class AEnemyBase;
+class UEnemyLocomotionSubsystem;
+
+// Which locomotion rules apply to an enemy
+enum class EEnemyLocomotionArchetype : uint8
+{
+	Pawn,	// Yaw-only look-at, range keeping + strafe, or flow field approach (AEnemyPawnBase)
+	Bot,	// Planar tank turn, forward/backward only when facing the target or the flow field (AEnemyBotBase)
+	Fly,	// Full look-at, hover + avoidance steering (AEnemyFlyBase)
+	Pod,	// Full look-at, stationary (AEnemyPodBase)
+};
+
+// What an enemy hands to the locomotion pass for one tick
+struct FEnemyLocomotionRequest
+{
+	AEnemyBase* Enemy = nullptr;
+	EEnemyLocomotionArchetype Archetype = EEnemyLocomotionArchetype::Pawn;
+
+	// Time since the enemy's last tick (larger than the frame time for throttled enemies)
+	float DeltaTime = 0.0f;
+
+	FVector TargetLocation = FVector::ZeroVector;
+
+	// RInterpTo speed
+	float RotationSpeed = 0.0f;
+
+	// Turn towards the target this tick
+	bool bRotate = false;
+
+	// Add movement input this tick (Pawn: the target is visible, the range check is done by the pass)
+	bool bMove = false;
+
+	// Pawn: PreferredMinRange / PreferredMaxRange, Bot: StopDistance / AttackRange
+	float MinRange = 0.0f;
+	float MaxRange = 0.0f;
+
+	// Pawn: StrafeSpeed, Fly: HoverMoveScale
+	float MoveScale = 1.0f;
+
+	// Pawn: -1 left, 0 none, 1 right
+	float StrafeScale = 0.0f;
+
+	// Fly: hover direction + obstacle avoidance, normalized by the pass
+	// Pawn/Bot: direction of the shared flow field toward the target (zero = straight at the target)
+	FVector SteerDirection = FVector::ZeroVector;
+};
+
+// Runs the locomotion pass in TG_PrePhysics, after the enemies' own ticks and before their movement components
+USTRUCT()
+struct FEnemyLocomotionTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	UEnemyLocomotionSubsystem* Subsystem = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FEnemyLocomotionTickFunction> : public TStructOpsTypeTraitsBase2<FEnemyLocomotionTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+/**
+ * UEnemyLocomotionSubsystem: Batched rotate/move step of every enemy archetype.
+ * Enemies keep deciding *whether* to turn and move in their own (significance throttled) tick, then submit a request.
+ * Once per frame the requests are processed as contiguous arrays: look-at rotations (FindLookAtRotation + RInterpTo)
+ * and movement intents are computed in one tight pass, then written back with SetActorRotation / AddMovementInput.
+ * The rules are the ones the enemy base classes used to run inline, unchanged.
+ * The pass is a tick function that every registered enemy's actor tick comes before and its movement component after,
+ * so the movement input is consumed in the same frame, exactly like the inline code.
+ */
+UCLASS()
+class ROBOQUEST_API UEnemyLocomotionSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	// Orders the enemy's ticks around the pass (actor tick -> pass -> movement component). Undone by UnregisterMover.
+	void RegisterMover(AEnemyBase* Enemy);
+	void UnregisterMover(AEnemyBase* Enemy);
+
+	// Queues the locomotion of one enemy for this frame's pass
+	void SubmitRequest(const FEnemyLocomotionRequest& Request);
+
+	// Computes and applies every request submitted this frame (from LocomotionTick)
+	void ProcessBatch();
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	FEnemyLocomotionTickFunction LocomotionTick;
+
+	// Reset (not freed) every frame
+	void ResetBatch();
+
+	// Computes NewRotations, MoveDirections and MoveScales from the inputs
+	void ComputeBatch();
+
+	// Applies the results to the actors
+	void WriteBack();
+
+	// --- Inputs (one element per request) ---
+	TArray<TWeakObjectPtr<AEnemyBase>> Enemies;
+	TArray<EEnemyLocomotionArchetype> Archetypes;
+	TArray<float> DeltaTimes;
+	TArray<FVector> Locations;
+	TArray<FRotator> Rotations;
+	TArray<FVector> TargetLocations;
+	TArray<float> RotationSpeeds;
+	TArray<uint8> Flags;
+	TArray<FVector2f> Ranges;
+	TArray<float> InputScales;
+	TArray<float> StrafeScales;
+	TArray<FVector> SteerDirections;
+
+	// --- Outputs ---
+	TArray<FRotator> NewRotations;
+	TArray<FVector> MoveDirections;
+	TArray<float> MoveScales;
+};
@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyPerceptionSubsystem.generated.h"
+
+class UEnemyPerceptionComponent;
+
+/**
+ * UEnemyPerceptionSubsystem: Budgeted scheduler of every enemy's UEnemyPerceptionComponent.
+ * Listeners are updated round-robin, each at most once per UpdateInterval and at most MaxUpdatesPerFrame per frame,
+ * so perception costs the same whatever the enemy count; an update is a cone test plus a cached LOS lookup.
+ * Noises (player shots) are queued and delivered in one pass per frame to the listeners within hearing range.
+ */
+UCLASS(config=Game)
+class ROBOQUEST_API UEnemyPerceptionSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Starts updating Listener (updated right away, so a fresh enemy does not wait for its turn)
+	void RegisterListener(UEnemyPerceptionComponent* Listener);
+
+	void UnregisterListener(UEnemyPerceptionComponent* Listener);
+
+	// A noise made by Source at Location, heard by the listeners within their HearingRange * Loudness
+	void ReportNoise(AActor* Source, const FVector& Location, float Loudness = 1.0f);
+
+	// Seconds between two updates of the same listener
+	UPROPERTY(Config, EditAnywhere, Category = "Perception")
+	float UpdateInterval = 0.2f;
+
+	// Listener updates per frame
+	UPROPERTY(Config, EditAnywhere, Category = "Perception")
+	int32 MaxUpdatesPerFrame = 48;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FListenerEntry
+	{
+		TWeakObjectPtr<UEnemyPerceptionComponent> Listener;
+		double LastUpdateTime = 0.0;
+	};
+
+	struct FNoiseEvent
+	{
+		TWeakObjectPtr<AActor> Source;
+		FVector Location = FVector::ZeroVector;
+		float Loudness = 1.0f;
+	};
+
+	// Delivers the queued noises
+	void DeliverNoises();
+
+	// Round-robin updates within the frame budget
+	void UpdateListeners(double Now);
+
+	TArray<FListenerEntry> Listeners;
+	TArray<FNoiseEvent> PendingNoises;
+
+	// Next listener to consider
+	int32 Cursor = 0;
+};
@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyPoolSubsystem.generated.h"
+
+class AEnemyBase;
+
+// Usage statistics of a single enemy pool
+USTRUCT(BlueprintType)
+struct FEnemyPoolStats
+{
+	GENERATED_BODY()
+
+	// Total number of enemies owned by the pool (free + in use)
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Pool")
+	int32 PoolSize = 0;
+
+	// Number of enemies currently alive (or still showing their corpse)
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Pool")
+	int32 ActiveCount = 0;
+
+	// Highest number of enemies that were in use at the same time
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Pool")
+	int32 HighWaterMark = 0;
+
+	// Number of acquisitions that found the pool empty and had to spawn a new actor
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Pool")
+	int32 Misses = 0;
+};
+
+// Free list and stats for one enemy class
+USTRUCT()
+struct FEnemyPool
+{
+	GENERATED_BODY()
+
+	// Parked enemies ready to be handed out
+	UPROPERTY()
+	TArray<TObjectPtr<AEnemyBase>> FreeEnemies;
+
+	FEnemyPoolStats Stats;
+};
+
+/**
+ * UEnemyPoolSubsystem: Recycles AEnemyBase actors so activating a combat zone does not spawn a burst of characters.
+ * Zones pre-warm the classes of their spawn points at BeginPlay, spawn points take enemies with AcquireEnemy() and
+ * dead enemies come back through ReleaseEnemy() once their corpse time (CorpseLifeSpan) is over.
+ */
+UCLASS()
+class ROBOQUEST_API UEnemyPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// Makes sure at least Count enemies of the given class exist in the pool
+	UFUNCTION(BlueprintCallable, Category = "Enemy Pool")
+	void PrewarmPool(TSubclassOf<AEnemyBase> EnemyClass, int32 Count);
+
+	// Takes an enemy out of the pool (spawning one if the pool is empty) and resets it at the given transform,
+	// with full health, its AI controller and its AI services registered, like a freshly spawned enemy.
+	AEnemyBase* AcquireEnemy(TSubclassOf<AEnemyBase> EnemyClass, const FVector& Location, const FRotator& Rotation);
+
+	// Parks an enemy back in its pool. Enemies that were not created by the pool are destroyed.
+	void ReleaseEnemy(AEnemyBase* Enemy);
+
+	// Returns the stats of the pool for the given class
+	UFUNCTION(BlueprintCallable, Category = "Enemy Pool")
+	FEnemyPoolStats GetPoolStats(TSubclassOf<AEnemyBase> EnemyClass) const;
+
+	// Prints the stats of every pool to the log
+	UFUNCTION(BlueprintCallable, Category = "Enemy Pool")
+	void LogPoolStats() const;
+
+private:
+	// Spawns a new parked enemy owned by the pool
+	AEnemyBase* SpawnPooledEnemy(UClass* EnemyClass);
+
+	// One pool per enemy class
+	UPROPERTY()
+	TMap<TObjectPtr<UClass>, FEnemyPool> Pools;
+};
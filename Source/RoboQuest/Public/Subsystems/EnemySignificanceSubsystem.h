@@ -0,0 +1,130 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemySignificanceSubsystem.generated.h"
+
+class AEnemyBase;
+class ACombatZone;
+
+// How much an enemy matters right now, from most to least expensive
+UENUM(BlueprintType)
+enum class EEnemySignificanceTier : uint8
+{
+	High UMETA(DisplayName = "High"),		// In range and on screen (or very close): full rate
+	Medium UMETA(DisplayName = "Medium"),	// In range but off screen, or near range and on screen
+	Low UMETA(DisplayName = "Low"),			// Far away
+	Dormant UMETA(DisplayName = "Dormant"),	// Its combat zone is not active: no ticking at all
+};
+
+// Tick intervals applied to an enemy for one tier (0 = every frame)
+USTRUCT(BlueprintType)
+struct FEnemySignificanceTierSettings
+{
+	GENERATED_BODY()
+
+	// Actor tick (AI logic: target, rotation, combat move)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Significance")
+	float ActorTickInterval = 0.0f;
+
+	// UCharacterMovementComponent update. Keep it >= ActorTickInterval, movement input is only added on actor ticks.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Significance")
+	float MovementTickInterval = 0.0f;
+
+	// Pose evaluation while on screen: once every this many frames (URO, skipped frames are interpolated).
+	// The mesh itself ticks every frame, so montages and their notifies stay on time.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Significance", meta = (ClampMin = "1"))
+	int32 AnimUpdateRate = 1;
+
+	// AI controller tick
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Significance")
+	float ControllerTickInterval = 0.0f;
+};
+
+/**
+ * UEnemySignificanceSubsystem: AI LOD for every registered enemy.
+ * Enemies are scored by distance to the nearest player (relative to their DetectRange), whether they were rendered
+ * recently and whether their combat zone is active. The resulting tier drives the actor, movement and controller
+ * tick intervals and the animation update rate (URO). Enemies of inactive zones stop ticking entirely.
+ * Evaluation is time-sliced (MaxEvaluationsPerFrame) and settings are only pushed to an enemy when its tier changes.
+ */
+UCLASS(config=Game)
+class ROBOQUEST_API UEnemySignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UEnemySignificanceSubsystem();
+
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Starts managing Enemy's tick rates (DetectRange in cm scales the distance thresholds)
+	void RegisterEnemy(AEnemyBase* Enemy, float DetectRange);
+
+	// Stops managing Enemy and restores full tick rates
+	void UnregisterEnemy(AEnemyBase* Enemy);
+
+	// Re-evaluates every enemy of Zone right away (e.g. when the zone activates)
+	void RefreshZone(const ACombatZone* Zone);
+
+	// Current tier of Enemy (High if not registered)
+	UFUNCTION(BlueprintCallable, Category = "Significance")
+	EEnemySignificanceTier GetTier(const AEnemyBase* Enemy) const;
+
+	// --- Config ---
+	UPROPERTY(Config, EditAnywhere, Category = "Significance")
+	FEnemySignificanceTierSettings HighTier;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Significance")
+	FEnemySignificanceTierSettings MediumTier;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Significance")
+	FEnemySignificanceTierSettings LowTier;
+
+	// Within DetectRange * this, an off-screen enemy still counts as High
+	UPROPERTY(Config, EditAnywhere, Category = "Significance")
+	float CloseRangeScale = 0.5f;
+
+	// Beyond DetectRange * this, an enemy is Low even when on screen
+	UPROPERTY(Config, EditAnywhere, Category = "Significance")
+	float MediumRangeScale = 2.0f;
+
+	// An enemy rendered within this many seconds counts as visible
+	UPROPERTY(Config, EditAnywhere, Category = "Significance")
+	float RecentlyRenderedTolerance = 0.25f;
+
+	// Number of enemies re-scored per frame (round robin)
+	UPROPERTY(Config, EditAnywhere, Category = "Significance")
+	int32 MaxEvaluationsPerFrame = 64;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FSignificanceEntry
+	{
+		TWeakObjectPtr<AEnemyBase> Enemy;
+		float DetectRange = 0.0f;
+		EEnemySignificanceTier Tier = EEnemySignificanceTier::High;
+	};
+
+	// Scores one enemy
+	EEnemySignificanceTier EvaluateTier(const AEnemyBase* Enemy, float DetectRange) const;
+
+	// Re-scores Entry and applies the new tier if it changed
+	void UpdateEntry(FSignificanceEntry& Entry);
+
+	// Pushes the tick settings of Tier to Enemy, its movement, mesh (URO) and controller
+	void ApplyTier(AEnemyBase* Enemy, EEnemySignificanceTier Tier) const;
+
+	const FEnemySignificanceTierSettings& GetTierSettings(EEnemySignificanceTier Tier) const;
+
+	TArray<FSignificanceEntry> Entries;
+
+	// Round robin position in Entries
+	int32 NextEntryIndex = 0;
+};
@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemySpawnSchedulerSubsystem.generated.h"
+
+class AEnemyBase;
+class AEnemySpawnPoint;
+class ACombatZone;
+
+/**
+ * UEnemySpawnSchedulerSubsystem: Spreads enemy creation over several frames.
+ * Combat zones queue their pool pre-warming (actor spawn, mesh and anim setup, AI controller possession) at BeginPlay
+ * and their spawn requests (with a per-wave delay) on activation. Every frame the queue is worked through until
+ * FrameBudgetMs is spent; spawns that are due go first, pre-warming uses what is left.
+ * At least one item is processed per frame, so the queue always drains.
+ */
+UCLASS(config=Game)
+class ROBOQUEST_API UEnemySpawnSchedulerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Adds Count parked enemies of EnemyClass to the enemy pool, a few per frame
+	void QueuePrewarm(TSubclassOf<AEnemyBase> EnemyClass, int32 Count);
+
+	// Spawns the enemy of Point (for Zone) once Delay seconds have passed and the frame budget allows it
+	void QueueSpawn(AEnemySpawnPoint* Point, ACombatZone* Zone, float Delay);
+
+	// Number of spawn requests not processed yet (due or waiting for their wave)
+	UFUNCTION(BlueprintCallable, Category = "Spawn Scheduler")
+	int32 GetNumPendingSpawns() const { return PendingSpawns.Num(); }
+
+	// Time the scheduler may spend per frame, in milliseconds
+	UPROPERTY(Config, EditAnywhere, Category = "Spawn Scheduler")
+	float FrameBudgetMs = 2.0f;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FSpawnRequest
+	{
+		TWeakObjectPtr<AEnemySpawnPoint> Point;
+		TWeakObjectPtr<ACombatZone> Zone;
+		double ReadyTime = 0.0;
+	};
+
+	struct FPrewarmRequest
+	{
+		TSubclassOf<AEnemyBase> EnemyClass;
+		int32 Remaining = 0;
+	};
+
+	// Spawns the enemy of one due request
+	void ProcessSpawn(const FSpawnRequest& Request);
+
+	// Adds one enemy to the pool for the first prewarm request
+	void ProcessPrewarm();
+
+	// Sorted by ReadyTime (oldest first)
+	TArray<FSpawnRequest> PendingSpawns;
+
+	TArray<FPrewarmRequest> PendingPrewarms;
+};
@@ -0,0 +1,76 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tasks/Task.h"
+#include "UObject/ObjectKey.h"
+#include "FlightNavigationSubsystem.generated.h"
+
+struct FOccupancyGridData;
+class AOccupancyGridVolume;
+
+// Receives the waypoints of a flight path (empty if no path was found), on the game thread
+typedef TFunction<void(const TArray<FVector>& Path)> FFlightPathCallback;
+
+/**
+ * UFlightNavigationSubsystem: Asynchronous 3D paths for flying enemies, over the voxels of the level's
+ * distance field (AOccupancyGridVolume). A voxel is flyable when its distance to the geometry is at least the
+ * agent's clearance, so the baked field doubles as the navigation data; no separate build is needed.
+ * A* runs on worker threads against the grid's shared read-only copy; results are handed back in Tick.
+ * Found paths are cached per grid volume, keyed by the start and goal bricks, since the static geometry never changes.
+ */
+UCLASS(config=Game)
+class ROBOQUEST_API UFlightNavigationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Starts a path query from Start to Goal for an agent of the given radius. OnComplete is called from a later Tick
+	// (or right away for a cached path). Returns false, without calling OnComplete, when no grid covers both ends.
+	bool RequestPath(const FVector& Start, const FVector& Goal, float AgentRadius, FFlightPathCallback OnComplete);
+
+	// Forgets the cached paths of every grid (e.g. after a grid rebuild)
+	void ClearPathCache();
+
+	// --- Config ---
+
+	// A* gives up after expanding this many voxels (keeps a worker from chewing on unreachable goals)
+	UPROPERTY(Config, EditAnywhere, Category = "Flight Navigation")
+	int32 MaxExpandedNodes = 20000;
+
+	// Cached paths per grid before the cache of that grid is flushed
+	UPROPERTY(Config, EditAnywhere, Category = "Flight Navigation")
+	int32 MaxCachedPathsPerGrid = 256;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FPathQuery
+	{
+		UE::Tasks::TTask<TArray<FVector>> Task;
+		FFlightPathCallback OnComplete;
+		TObjectKey<AOccupancyGridVolume> Volume;
+		uint64 CacheKey = 0;
+	};
+
+	// A* from Start to Goal over the voxels with at least MinClearance, then string-pulled (runs on a worker)
+	static TArray<FVector> FindPath(const FOccupancyGridData& Grid, const FVector& Start, const FVector& Goal, uint8 MinClearance, int32 MaxExpandedNodes);
+
+	// Nearest flyable voxel within a couple of voxels of Voxel (agents hugging a wall start inside the clearance)
+	static bool FindFlyableVoxel(const FOccupancyGridData& Grid, FIntVector& InOutVoxel, uint8 MinClearance);
+
+	// Is the straight segment between two locations flyable?
+	static bool IsSegmentFlyable(const FOccupancyGridData& Grid, const FVector& From, const FVector& To, uint8 MinClearance);
+
+	TArray<FPathQuery> PendingQueries;
+
+	// Per grid volume: start brick + goal brick + clearance -> waypoints between the two ends
+	TMap<TObjectKey<AOccupancyGridVolume>, TMap<uint64, TArray<FVector>>> PathCache;
+};
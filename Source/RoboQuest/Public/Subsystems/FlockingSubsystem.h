@@ -0,0 +1,91 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "FlockingSubsystem.generated.h"
+
+class AEnemyBase;
+
+/**
+ * UFlockingSubsystem: Separation / alignment / cohesion steering between flying enemies.
+ * Once per frame the live agents are hashed into a uniform grid (cell size = NeighborRadius), then each agent only
+ * looks at the 3x3x3 cells around it: O(n) for hundreds of flies and no collision query for fly-vs-fly avoidance.
+ * Agents read the result of the last pass with GetSteering() and add it to their own steering.
+ */
+UCLASS()
+class ROBOQUEST_API UFlockingSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Adds an agent to the flock. Dead agents (e.g. parked in the enemy pool) are skipped until they are alive again.
+	void RegisterAgent(AEnemyBase* Agent);
+
+	void UnregisterAgent(AEnemyBase* Agent);
+
+	// Flocking steering of Agent from the last pass (zero without neighbors), at most 1 long
+	FVector GetSteering(const AEnemyBase* Agent) const;
+
+	// --- Config ---
+
+	// Agents within this distance are neighbors (also the grid cell size)
+	UPROPERTY(EditAnywhere, Category = "Flocking")
+	float NeighborRadius = 400.0f;
+
+	// Agents closer than this push each other away
+	UPROPERTY(EditAnywhere, Category = "Flocking")
+	float SeparationRadius = 200.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Flocking")
+	float SeparationWeight = 1.5f;
+
+	UPROPERTY(EditAnywhere, Category = "Flocking")
+	float AlignmentWeight = 0.3f;
+
+	UPROPERTY(EditAnywhere, Category = "Flocking")
+	float CohesionWeight = 0.2f;
+
+	// Nearest neighbors taken into account per agent (bounds the steering work inside very dense clumps)
+	UPROPERTY(EditAnywhere, Category = "Flocking")
+	int32 MaxNeighbors = 8;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	// Gathers the live agents, rebuilds the grid and computes every steering
+	void UpdateFlock();
+
+	FIntVector GetCell(const FVector& Location) const;
+
+	TArray<TWeakObjectPtr<AEnemyBase>> Agents;
+
+	// Result of the last pass (agents without neighbors are left out)
+	TMap<TObjectKey<AEnemyBase>, FVector> SteeringByAgent;
+
+	// --- Per-frame scratch (reset, not freed) ---
+
+	// Every live agent, and their positions / velocities
+	TArray<AEnemyBase*> LiveAgents;
+	TArray<FVector> Positions;
+	TArray<FVector> Velocities;
+
+	// Grid: first live agent of each occupied cell, then the next agent in the same cell
+	TMap<FIntVector, int32> CellHeads;
+	TArray<int32> NextInCell;
+
+	// Nearest neighbors of the current agent: max-heap on squared distance, at most MaxNeighbors entries
+	struct FNeighbor
+	{
+		float DistSq;
+		int32 Index;
+	};
+	TArray<FNeighbor> NearestNeighbors;
+};
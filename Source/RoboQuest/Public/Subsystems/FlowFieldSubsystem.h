@@ -0,0 +1,143 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tasks/Task.h"
+#include "FlowFieldSubsystem.generated.h"
+
+/**
+ * UFlowFieldSubsystem: One shared navigation field per target (player) for ground enemies.
+ * A square window of cells around the target is sampled against the navmesh (projection + links between
+ * neighbors), a few hundred queries per frame. A Dijkstra pass from the target's cell then runs on a worker thread
+ * and gives every cell the direction of its downhill neighbor. Enemies just read the direction of their cell,
+ * so the path cost no longer grows with the number of enemies chasing the same player.
+ * The window is resampled only when the target gets close to its edge; the solve reruns when the target changes cell.
+ * Fields toward a fixed location (where a target was last sensed) are shared per goal cell and reuse the sampled
+ * window of another field when one covers the goal, so they usually only cost a solve.
+ */
+UCLASS(config=Game)
+class ROBOQUEST_API UFlowFieldSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Direction to walk from Location to reach Target around the walls. Starts a field for Target if there is none.
+	// Returns false while the field is not ready, outside of it, on another floor, or when the target is unreachable.
+	bool GetFlowDirection(AActor* Target, const FVector& Location, FVector& OutDirection);
+
+	// Same toward a fixed location (e.g. the last known location of a target out of sight). Starts a field if needed.
+	bool GetFlowDirectionToLocation(const FVector& Goal, const FVector& Location, FVector& OutDirection);
+
+	// --- Config ---
+
+	// Edge length of a cell
+	UPROPERTY(Config, EditAnywhere, Category = "Flow Field")
+	float CellSize = 100.0f;
+
+	// Cells per window edge
+	UPROPERTY(Config, EditAnywhere, Category = "Flow Field")
+	int32 WindowSize = 96;
+
+	// The window moves when the target gets this many cells away from its edge
+	UPROPERTY(Config, EditAnywhere, Category = "Flow Field")
+	int32 RecenterMargin = 16;
+
+	// Navmesh projections and raycasts spent per frame on sampling windows
+	UPROPERTY(Config, EditAnywhere, Category = "Flow Field")
+	int32 MaxNavQueriesPerFrame = 512;
+
+	// Height range searched for the navmesh around the target height
+	UPROPERTY(Config, EditAnywhere, Category = "Flow Field")
+	float VerticalExtent = 500.0f;
+
+	// Enemies further than this above or below their cell are on another floor
+	UPROPERTY(Config, EditAnywhere, Category = "Flow Field")
+	float MaxHeightDifference = 200.0f;
+
+	// Fields nobody asked for during this long are dropped
+	UPROPERTY(Config, EditAnywhere, Category = "Flow Field")
+	float FieldIdleTimeout = 5.0f;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	// Per-cell flags of a window
+	enum ECellFlags : uint8
+	{
+		Walkable = 1 << 0,
+		LinkX = 1 << 1,		// Connected to the +X neighbor
+		LinkY = 1 << 2,		// Connected to the +Y neighbor
+	};
+
+	// Navmesh layer sampled around an anchor (read-only once complete, shared with the solver)
+	struct FFlowWindow
+	{
+		FIntPoint Origin = FIntPoint::ZeroValue;	// Global cell of the min corner
+		int32 Size = 0;
+		float AnchorZ = 0.0f;
+		TArray<float> Heights;
+		TArray<uint8> Flags;
+
+		int32 ToIndex(const FIntPoint& Cell) const { return (Cell.X - Origin.X) + (Cell.Y - Origin.Y) * Size; }
+		bool Contains(const FIntPoint& Cell) const { return Cell.X >= Origin.X && Cell.Y >= Origin.Y && Cell.X < Origin.X + Size && Cell.Y < Origin.Y + Size; }
+	};
+
+	typedef TSharedPtr<const FFlowWindow, ESPMode::ThreadSafe> FFlowWindowPtr;
+
+	struct FFlowField
+	{
+		// Followed actor, or a fixed goal location
+		TWeakObjectPtr<AActor> Target;
+		bool bFixedGoal = false;
+		FVector GoalLocation = FVector::ZeroVector;
+
+		float LastQueryTime = 0.0f;
+
+		// Sampled window and the directions solved on it (per cell: neighbor index, or NoDirection)
+		FFlowWindowPtr Window;
+		TArray<uint8> Directions;
+		FIntPoint SolvedGoal = FIntPoint(MAX_int32, MAX_int32);
+
+		// Window being sampled (Phase 0: projections, 1: links)
+		TSharedPtr<FFlowWindow, ESPMode::ThreadSafe> PendingWindow;
+		int32 SamplePhase = 0;
+		int32 NextSampleIndex = 0;
+
+		// Running solve
+		UE::Tasks::TTask<TArray<uint8>> SolveTask;
+		FFlowWindowPtr SolvingWindow;
+		FIntPoint SolvingGoal = FIntPoint::ZeroValue;
+		bool bSolving = false;
+	};
+
+	// Direction markers
+	static constexpr uint8 NoDirection = 255;
+	static constexpr uint8 AtGoal = 254;
+
+	FIntPoint WorldToCell(const FVector& Location) const;
+	FVector CellToWorld(const FIntPoint& Cell, float Z) const;
+
+	// Current goal of a field (its target's location, or its fixed goal)
+	static FVector GetGoalLocation(const FFlowField& Field);
+
+	// Does a goal at Cell / GoalZ call for a new window (none yet, too close to the edge, another floor)?
+	bool NeedsNewWindow(const FFlowWindow* Window, const FIntPoint& Cell, float GoalZ) const;
+
+	// Direction of the cell under Location in Field (shared by both queries)
+	bool ReadFlowDirection(FFlowField& Field, const FVector& Location, FVector& OutDirection);
+
+	// Spends up to Budget nav queries on the pending window of Field. Returns the queries used.
+	int32 SampleWindow(FFlowField& Field, int32 Budget);
+
+	// Dijkstra from Goal over the window; per cell, the index of the neighbor to walk to (runs on a worker)
+	static TArray<uint8> SolveField(const FFlowWindow& Window, FIntPoint Goal);
+
+	TArray<FFlowField> Fields;
+};
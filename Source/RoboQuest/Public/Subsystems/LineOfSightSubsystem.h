@@ -0,0 +1,94 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "LineOfSightSubsystem.generated.h"
+
+/**
+ * ULineOfSightSubsystem: Answers "can Viewer see Target" for every enemy from a cache instead of tracing inline.
+ * Each (viewer, target) pair keeps its last known visibility. When that result is older than StalenessWindow the
+ * pair is queued, and queued pairs are traced with AsyncLineTraceByChannel, at most MaxTracesPerFrame per frame.
+ * Callers always get the last known result immediately (false until the first trace completes).
+ * Tunables are read from DefaultGame.ini ([/Script/RoboQuest.LineOfSightSubsystem]).
+ */
+UCLASS(config=Game)
+class ROBOQUEST_API ULineOfSightSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Last known visibility of Target from Viewer's location + EyeOffset (Viewer and Target are ignored by the trace).
+	// Schedules a refresh when the cached result is stale.
+	bool HasLineOfSight(const AActor* Viewer, const AActor* Target, const FVector& EyeOffset = FVector::ZeroVector);
+
+	// --- Config ---
+
+	// Age in seconds after which a cached result is traced again
+	UPROPERTY(Config, EditAnywhere, Category = "Line Of Sight")
+	float StalenessWindow = 0.2f;
+
+	// Maximum number of async traces started per frame
+	UPROPERTY(Config, EditAnywhere, Category = "Line Of Sight")
+	int32 MaxTracesPerFrame = 64;
+
+	// Pairs nobody asked about for this long are dropped from the cache
+	UPROPERTY(Config, EditAnywhere, Category = "Line Of Sight")
+	float EvictAfter = 2.0f;
+
+	// Maximum number of cache slots checked for eviction per frame
+	UPROPERTY(Config, EditAnywhere, Category = "Line Of Sight")
+	int32 MaxEvictionChecksPerFrame = 128;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FLineOfSightEntry
+	{
+		TWeakObjectPtr<const AActor> Viewer;
+		TWeakObjectPtr<const AActor> Target;
+		FVector EyeOffset = FVector::ZeroVector;
+
+		bool bVisible = false;
+		bool bQueued = false;
+		bool bTraceInFlight = false;
+
+		double LastResultTime = -1.0;
+		double LastRequestTime = 0.0;
+	};
+
+	// Cache key of a (viewer, target) pair
+	static uint64 MakeKey(const AActor* Viewer, const AActor* Target);
+
+	// Starts queued traces within the per-frame budget
+	void StartQueuedTraces();
+
+	// Drops pairs that are no longer asked about or whose actors are gone, resuming where the last frame stopped
+	void EvictUnusedEntries(double Now);
+
+	// Async trace callback
+	void OnTraceCompleted(const FTraceHandle& Handle, FTraceDatum& Datum);
+
+	TMap<uint64, FLineOfSightEntry> Entries;
+
+	// Keys waiting for a trace, oldest first, starting at TraceQueueHead
+	TArray<uint64> TraceQueue;
+	int32 TraceQueueHead = 0;
+
+	// Next cache slot checked by EvictUnusedEntries
+	int32 EvictionCursor = 0;
+
+	// Key of every trace in flight, by the UserData passed to the async trace
+	TMap<uint32, uint64> InFlightTraces;
+	uint32 NextTraceId = 0;
+
+	FTraceDelegate TraceDelegate;
+};
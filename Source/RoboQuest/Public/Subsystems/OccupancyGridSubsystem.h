@@ -0,0 +1,32 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "OccupancyGridSubsystem.generated.h"
+
+class AOccupancyGridVolume;
+
+/**
+ * UOccupancyGridSubsystem: Finds the precomputed distance field (AOccupancyGridVolume) covering a location.
+ * Volumes register themselves at BeginPlay; a level usually has a handful of them at most.
+ */
+UCLASS()
+class ROBOQUEST_API UOccupancyGridSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	void RegisterVolume(AOccupancyGridVolume* Volume);
+
+	void UnregisterVolume(AOccupancyGridVolume* Volume);
+
+	// Built grid containing Location, or null (callers then fall back to physics queries)
+	const AOccupancyGridVolume* FindVolume(const FVector& Location) const;
+
+private:
+	TArray<TWeakObjectPtr<AOccupancyGridVolume>> Volumes;
+};
@@ -0,0 +1,131 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PickupSubsystem.generated.h"
+
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+class AHealingCell;
+
+// A healing cell once its spawn pop is over: no actor, no physics body, no overlap sphere
+struct FHealingCellPickup
+{
+	FVector Location = FVector::ZeroVector;
+	FRotator Rotation = FRotator::ZeroRotator;
+
+	// Scale of a single-drop cell (the stack scale is applied on top)
+	FVector Scale = FVector::OneVector;
+
+	// Summed heal of every drop merged into this cell
+	float HealAmount = 0.0f;
+	int32 StackCount = 1;
+
+	// When the first drop of the stack spawned (merging stops MergeWindow later)
+	float SpawnTime = 0.0f;
+
+	float MagnetDetectRange = 0.0f;
+	float MagnetFlySpeed = 0.0f;
+
+	// Collected when this close to the homing point of its target
+	float CollectRadius = 0.0f;
+
+	// Player the cell flies to, once magnetized
+	TWeakObjectPtr<AActor> Target;
+};
+
+// All cells drawn with one static mesh, by one instanced static mesh
+USTRUCT()
+struct FPickupMeshGroup
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<UStaticMesh> Mesh;
+
+	// One instance per cell, in the same order as Cells
+	UPROPERTY()
+	TObjectPtr<UInstancedStaticMeshComponent> Instances;
+
+	TArray<FHealingCellPickup> Cells;
+};
+
+/**
+ * UPickupSubsystem: Every healing cell on the ground, in one contiguous array per mesh.
+ * AHealingCell actors only exist for their physics "pop" on spawn, then hand themselves over (AddHealingCell).
+ * One update per frame runs the magnet check, the VInterpConstantTo homing and the collection of every cell,
+ * and the cells of each static mesh are drawn by one instanced static mesh.
+ * Drops landing within MergeRadius of each other within MergeWindow merge into one cell carrying the summed heal;
+ * the stack count is written to custom data 0 (per instance, or custom primitive data while popping) and scales the cell.
+ */
+UCLASS(config=Game)
+class ROBOQUEST_API UPickupSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Takes over a cell that finished popping (merged into a nearby one when possible).
+	// The cell is drawn with Mesh at Scale (times its stack scale).
+	void AddHealingCell(const FHealingCellPickup& Cell, UStaticMesh* Mesh, const FVector& Scale);
+
+	// Adds a new drop to a cell dropped nearby a moment ago (popping or on the ground, not flying to a player yet).
+	// Returns false when there is none: the caller spawns a cell of its own.
+	bool MergeDrop(const FVector& Location, float HealAmount, int32 StackCount = 1);
+
+	// Cells popping on spawn, open to merges
+	void RegisterPoppingCell(AHealingCell* Cell);
+	void UnregisterPoppingCell(AHealingCell* Cell);
+
+	// Scale multiplier of a cell carrying StackCount drops
+	float GetStackScale(int32 StackCount) const;
+
+	// Cells waiting on the ground or flying to a player
+	UFUNCTION(BlueprintCallable, Category = "Pickups")
+	int32 GetNumHealingCells() const;
+
+	// Drops closer than this merge
+	UPROPERTY(Config, EditAnywhere, Category = "Pickups")
+	float MergeRadius = 250.0f;
+
+	// Seconds after the first drop of a cell during which it accepts merges
+	UPROPERTY(Config, EditAnywhere, Category = "Pickups")
+	float MergeWindow = 1.0f;
+
+	// Extra scale per merged drop, up to MaxStackScale
+	UPROPERTY(Config, EditAnywhere, Category = "Pickups")
+	float StackScalePerDrop = 0.1f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Pickups")
+	float MaxStackScale = 2.0f;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	// Finds or creates the group (and instanced mesh) of Mesh
+	FPickupMeshGroup& GetOrAddGroup(UStaticMesh* Mesh);
+
+	// Magnet, homing and collection of every cell of Group
+	void UpdateCells(FPickupMeshGroup& Group, float DeltaTime);
+
+	// Instance i draws cell i of Group
+	void RefreshInstances(FPickupMeshGroup& Group);
+
+	UPROPERTY()
+	TArray<FPickupMeshGroup> Groups;
+
+	TArray<TWeakObjectPtr<AHealingCell>> PoppingCells;
+
+	// Owns the instanced meshes
+	UPROPERTY()
+	TObjectPtr<AActor> ProxyActor;
+
+	// Scratch buffer for the instance transforms
+	TArray<FTransform> InstanceTransforms;
+};
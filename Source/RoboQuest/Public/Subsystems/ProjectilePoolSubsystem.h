@@ -0,0 +1,124 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ProjectilePoolSubsystem.generated.h"
+
+class ARoboQuestProjectile;
+class ARoboQuestPelletBatch;
+
+// Usage statistics of a single projectile pool
+USTRUCT(BlueprintType)
+struct FProjectilePoolStats
+{
+	GENERATED_BODY()
+
+	// Total number of projectiles owned by the pool (free + in use)
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Pool")
+	int32 PoolSize = 0;
+
+	// Number of projectiles currently in flight
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Pool")
+	int32 ActiveCount = 0;
+
+	// Highest number of projectiles that were in flight at the same time
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Pool")
+	int32 HighWaterMark = 0;
+
+	// Number of acquisitions that found the pool empty and had to spawn a new actor
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Pool")
+	int32 Misses = 0;
+};
+
+// Free list and stats for one pooled class (projectile or pellet batch)
+USTRUCT()
+struct FProjectilePool
+{
+	GENERATED_BODY()
+
+	// Inactive actors ready to be handed out
+	UPROPERTY()
+	TArray<TObjectPtr<AActor>> FreeActors;
+
+	FProjectilePoolStats Stats;
+};
+
+/**
+ * UProjectilePoolSubsystem: Recycles ARoboQuestProjectile actors instead of spawning/destroying one per shot.
+ * Projectiles are pre-warmed per class, handed out with AcquireProjectile() and come back through ReleaseProjectile()
+ * when they hit something or their lifespan expires.
+ * Pellet batches (multi-bullet shots) are recycled the same way through AcquirePelletBatch() / ReleasePelletBatch();
+ * both go through the same templated pool code.
+ */
+UCLASS(config=Game)
+class ROBOQUEST_API UProjectilePoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// Makes sure at least Count projectiles of the given class exist in the pool
+	UFUNCTION(BlueprintCallable, Category = "Projectile Pool")
+	void PrewarmPool(TSubclassOf<ARoboQuestProjectile> ProjectileClass, int32 Count);
+
+	// Makes sure at least Count pellet batches of the given class exist in the pool
+	UFUNCTION(BlueprintCallable, Category = "Projectile Pool")
+	void PrewarmPelletBatches(TSubclassOf<ARoboQuestPelletBatch> BatchClass, int32 Count);
+
+	// Takes a projectile out of the pool (spawning one if the pool is empty) and places it at the given transform.
+	// The caller is expected to call InitializeProjectile() on the result, exactly like after SpawnActor.
+	ARoboQuestProjectile* AcquireProjectile(TSubclassOf<ARoboQuestProjectile> ProjectileClass, const FVector& Location, const FRotator& Rotation, AActor* NewOwner, APawn* NewInstigator);
+
+	// Puts a projectile back into its pool. Projectiles that were not created by the pool are destroyed.
+	void ReleaseProjectile(ARoboQuestProjectile* Projectile);
+
+	// Takes a pellet batch out of the pool (spawning one if the pool is empty) and places it at the given transform.
+	// The caller is expected to call InitializePellets() on the result, exactly like after SpawnActor.
+	ARoboQuestPelletBatch* AcquirePelletBatch(TSubclassOf<ARoboQuestPelletBatch> BatchClass, const FVector& Location, const FRotator& Rotation, AActor* NewOwner, APawn* NewInstigator);
+
+	// Puts a pellet batch back into its pool. Batches that were not created by the pool are destroyed.
+	void ReleasePelletBatch(ARoboQuestPelletBatch* Batch);
+
+	// Returns the stats of the pool for the given class
+	UFUNCTION(BlueprintCallable, Category = "Projectile Pool")
+	FProjectilePoolStats GetPoolStats(TSubclassOf<ARoboQuestProjectile> ProjectileClass) const;
+
+	// Returns the stats of the pool for the given pellet batch class
+	UFUNCTION(BlueprintCallable, Category = "Projectile Pool")
+	FProjectilePoolStats GetPelletBatchPoolStats(TSubclassOf<ARoboQuestPelletBatch> BatchClass) const;
+
+	// Prints the stats of every pool to the log
+	UFUNCTION(BlueprintCallable, Category = "Projectile Pool")
+	void LogPoolStats() const;
+
+	// Number of projectiles created per class the first time a pool is used
+	UPROPERTY(Config, EditAnywhere, Category = "Projectile Pool")
+	int32 DefaultPrewarmCount = 16;
+
+	// Same for pellet batches (one batch per shot, so a few are enough)
+	UPROPERTY(Config, EditAnywhere, Category = "Projectile Pool")
+	int32 DefaultPelletBatchPrewarmCount = 4;
+
+private:
+	// --- Shared by projectiles and pellet batches (ActorType: ARoboQuestProjectile or ARoboQuestPelletBatch) ---
+
+	template<typename ActorType>
+	void PrewarmActors(UClass* ActorClass, int32 Count);
+
+	template<typename ActorType>
+	ActorType* AcquireActor(UClass* ActorClass, int32 PrewarmCount, const FVector& Location, const FRotator& Rotation, AActor* NewOwner, APawn* NewInstigator);
+
+	template<typename ActorType>
+	void ReleaseActor(ActorType* Actor);
+
+	// Spawns a new inactive actor owned by the pool
+	template<typename ActorType>
+	ActorType* SpawnPooledActor(UClass* ActorClass);
+
+	// One pool per class (projectile and pellet batch classes never overlap)
+	UPROPERTY()
+	TMap<TObjectPtr<UClass>, FProjectilePool> Pools;
+};
@@ -0,0 +1,127 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SwarmSubsystem.generated.h"
+
+class AEnemyBase;
+class UInstancedStaticMeshComponent;
+
+// A distant enemy reduced to plain data: no actor, no movement component, no skeletal mesh
+struct FSwarmEntity
+{
+	FVector Location = FVector::ZeroVector;
+	FRotator Rotation = FRotator::ZeroRotator;
+	FVector HoverDirection = FVector::ZeroVector;
+	float HoverTimeLeft = 0.0f;
+
+	// Health carried over to/from the UStatusComponent of the full actor, as a fraction of MaxHealth
+	float HealthFraction = 1.0f;
+};
+
+// All swarm entities of one enemy class, drawn by one instanced static mesh
+USTRUCT()
+struct FSwarmClass
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TSubclassOf<AEnemyBase> EnemyClass;
+
+	// One instance per entity, in the same order as Entities
+	UPROPERTY()
+	TObjectPtr<UInstancedStaticMeshComponent> Instances;
+
+	TArray<FSwarmEntity> Entities;
+
+	// Hover model, read from the class defaults (AEnemyFlyBase); stationary classes (pods) only turn
+	float Speed = 0.0f;
+	float PreferredMinRange = 0.0f;
+	float PreferredMaxRange = 0.0f;
+	float HoverChangeInterval = 3.0f;
+	FVector ProxyScale = FVector::OneVector;
+};
+
+/**
+ * USwarmSubsystem: Hybrid representation for large swarms (ALightFly, ASmallPod...).
+ * Far from every player, an enemy only exists as an FSwarmEntity (transform, health, a cheap target-following hover
+ * model) rendered through one instanced static mesh per class. Entities within PromoteDistance are promoted to full
+ * AEnemyBase actors taken from the UEnemyPoolSubsystem; promoted actors beyond DemoteDistance go back to being entities.
+ * Promotions/demotions are capped per frame so a swarm rushing in doesn't spawn hundreds of characters at once.
+ */
+UCLASS(config=Game)
+class ROBOQUEST_API USwarmSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Adds a lightweight entity of EnemyClass (promoted right away if a player is already close)
+	UFUNCTION(BlueprintCallable, Category = "Swarm")
+	void AddSwarmEntity(TSubclassOf<AEnemyBase> EnemyClass, const FVector& Location, const FRotator& Rotation);
+
+	// Number of enemies currently simulated as entities
+	UFUNCTION(BlueprintCallable, Category = "Swarm")
+	int32 GetNumEntities() const;
+
+	// Number of swarm enemies currently promoted to full actors
+	UFUNCTION(BlueprintCallable, Category = "Swarm")
+	int32 GetNumPromoted() const { return Promoted.Num(); }
+
+	// Entities closer than this to a player become full actors
+	UPROPERTY(Config, EditAnywhere, Category = "Swarm")
+	float PromoteDistance = 3000.0f;
+
+	// Promoted actors farther than this from every player become entities again (> PromoteDistance, hysteresis)
+	UPROPERTY(Config, EditAnywhere, Category = "Swarm")
+	float DemoteDistance = 4000.0f;
+
+	// Caps on representation changes per frame
+	UPROPERTY(Config, EditAnywhere, Category = "Swarm")
+	int32 MaxPromotionsPerFrame = 4;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Swarm")
+	int32 MaxDemotionsPerFrame = 4;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FPromotedEnemy
+	{
+		TWeakObjectPtr<AEnemyBase> Enemy;
+		int32 ClassIndex = INDEX_NONE;
+	};
+
+	// Finds or creates the data (and instanced mesh) of EnemyClass
+	int32 GetOrAddClass(TSubclassOf<AEnemyBase> EnemyClass);
+
+	// Moves the entities of one class, promotes the close ones and refreshes its instances
+	void UpdateClass(FSwarmClass& SwarmClass, int32 ClassIndex, float DeltaTime, int32& NumPromotions);
+
+	// Same steering as AEnemyFlyBase::PickNewHoverDirection
+	FVector PickHoverDirection(const FSwarmClass& SwarmClass, const FVector& Location, const AActor* Target) const;
+
+	// Replaces an entity with a full actor
+	AEnemyBase* Promote(const FSwarmClass& SwarmClass, int32 ClassIndex, const FSwarmEntity& Entity);
+
+	// Turns far promoted actors back into entities
+	void DemoteFarEnemies();
+
+	UPROPERTY()
+	TArray<FSwarmClass> Classes;
+
+	// Owns the instanced meshes
+	UPROPERTY()
+	TObjectPtr<AActor> ProxyActor;
+
+	TArray<FPromotedEnemy> Promoted;
+
+	// Scratch buffer for the instance transforms
+	TArray<FTransform> InstanceTransforms;
+};
@@ -0,0 +1,91 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "TargetingSubsystem.generated.h"
+
+/**
+ * UTargetingSubsystem: Shared target acquisition for every enemy (and anything else that homes on players).
+ * Once per frame it caches the valid targets (player pawns) in a 2D spatial grid, then resolves the nearest
+ * target in range for every registered seeker in one pass.
+ * Seekers register once (RegisterSeeker) and read their result with GetTargetFor() instead of polling
+ * GetPlayerCharacter() and computing distances themselves, so the cost stays flat with hundreds of enemies
+ * and works with any number of players.
+ */
+UCLASS()
+class ROBOQUEST_API UTargetingSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Subscribes Seeker to target resolution within Range (cm). Calling it again updates the range.
+	void RegisterSeeker(AActor* Seeker, float Range);
+
+	// Stops resolving targets for Seeker
+	void UnregisterSeeker(AActor* Seeker);
+
+	// Nearest valid target within the seeker's range, as of the last update (nullptr if none or not registered)
+	AActor* GetTargetFor(const AActor* Seeker) const;
+
+	// Nearest valid target within Range of Location (Range <= 0 means any distance)
+	UFUNCTION(BlueprintCallable, Category = "Targeting")
+	AActor* FindNearestTarget(const FVector& Location, float Range) const;
+
+	// Number of valid targets cached this frame
+	UFUNCTION(BlueprintCallable, Category = "Targeting")
+	int32 GetNumTargets() const { return Targets.Num(); }
+
+	// Size of one grid cell in cm
+	UPROPERTY(EditAnywhere, Category = "Targeting")
+	float CellSize = 1000.0f;
+
+	// Below this many targets a linear scan is cheaper than walking grid cells
+	UPROPERTY(EditAnywhere, Category = "Targeting")
+	int32 LinearScanThreshold = 8;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	// Collects the valid targets and rebuilds the grid
+	void RefreshTargets();
+
+	// Resolves the nearest target of every seeker
+	void ResolveSeekers();
+
+	// Grid cell containing Location
+	FIntPoint GetCell(const FVector& Location) const;
+
+	// Index into Targets of the nearest target within Range (<= 0: any distance), or INDEX_NONE
+	int32 FindNearestTargetIndex(const FVector& Location, float Range) const;
+
+	struct FTargetEntry
+	{
+		TWeakObjectPtr<AActor> Actor;
+		FVector Location = FVector::ZeroVector;
+	};
+
+	struct FSeekerEntry
+	{
+		TWeakObjectPtr<AActor> Seeker;
+		float Range = 0.0f;
+		TWeakObjectPtr<AActor> Target;
+	};
+
+	// Targets cached this frame
+	TArray<FTargetEntry> Targets;
+
+	// Indices into Targets, bucketed by grid cell
+	TMap<FIntPoint, TArray<int32>> TargetGrid;
+
+	// Registered seekers (packed, removed with swap)
+	TArray<FSeekerEntry> Seekers;
+	TMap<TObjectKey<AActor>, int32> SeekerIndices;
+};
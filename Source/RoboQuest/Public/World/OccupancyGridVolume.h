@@ -0,0 +1,155 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "OccupancyGridVolume.generated.h"
+
+class UBoxComponent;
+class UPrimitiveComponent;
+
+/**
+ * Cooked distance field of an AOccupancyGridVolume, stored as sparse 8x8x8 bricks.
+ * Read-only once built, so worker threads can query a shared copy (see UFlightNavigationSubsystem).
+ */
+USTRUCT()
+struct FOccupancyGridData
+{
+	GENERATED_BODY()
+
+	// Voxels per brick edge
+	static constexpr int32 BrickSize = 8;
+	static constexpr int32 VoxelsPerBrick = BrickSize * BrickSize * BrickSize;
+
+	// Uniform brick markers in BrickIndices (otherwise an index into BrickDistances, in bricks)
+	static constexpr int32 FreeBrick = -1;
+	static constexpr int32 SolidBrick = -2;
+
+	// World location of the min corner of voxel (0,0,0)
+	UPROPERTY()
+	FVector Origin = FVector::ZeroVector;
+
+	UPROPERTY()
+	float VoxelSize = 100.0f;
+
+	UPROPERTY()
+	float MaxDistance = 800.0f;
+
+	UPROPERTY()
+	FIntVector NumVoxels = FIntVector::ZeroValue;
+
+	UPROPERTY()
+	FIntVector NumBricks = FIntVector::ZeroValue;
+
+	// One entry per brick: FreeBrick, SolidBrick, or the index of its voxels in BrickDistances
+	UPROPERTY()
+	TArray<int32> BrickIndices;
+
+	// VoxelsPerBrick distances per non-uniform brick, quantized over [0, MaxDistance]
+	UPROPERTY()
+	TArray<uint8> BrickDistances;
+
+	bool IsBuilt() const { return BrickIndices.Num() > 0; }
+
+	// Voxel containing a world location (may be outside the grid)
+	FIntVector WorldToVoxel(const FVector& Location) const;
+
+	// World location of the center of a voxel
+	FVector VoxelToWorld(const FIntVector& Voxel) const;
+
+	bool IsInside(const FIntVector& Voxel) const;
+
+	// Quantized distance of a voxel (0 = inside geometry, 255 = MaxDistance or further, also outside the grid)
+	uint8 GetVoxelValue(const FIntVector& Voxel) const;
+
+	// Distance to quantized value, rounded up (for clearance tests)
+	uint8 QuantizeDistance(float Distance) const;
+
+	// Distance from Location to the nearest static geometry (MaxDistance when far away or outside the grid)
+	float SampleDistance(const FVector& Location) const;
+
+	// Same, plus the direction pointing away from the geometry (zero when far away)
+	float SampleDistanceAndGradient(const FVector& Location, FVector& OutGradient) const;
+};
+
+/**
+ * AOccupancyGridVolume: Precomputed distance field of the static geometry inside its box.
+ * Built in the editor ("Build Grid") and saved with the level, so flying enemies can steer around walls and
+ * ground with a few memory reads instead of physics queries (see AEnemyFlyBase::CalculateObstacleAvoidance).
+ * The grid is stored as sparse 8x8x8 bricks: bricks far from any geometry cost one index and no voxel data.
+ * Movable blocking objects found inside the box at build time are listed, so enemies near them can still sweep.
+ * The grid is axis-aligned in world space (the actor rotation is ignored).
+ */
+UCLASS()
+class ROBOQUEST_API AOccupancyGridVolume : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AOccupancyGridVolume();
+
+	// Area covered by the grid, meant to be scaled in the level
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+	UBoxComponent* Bounds;
+
+	// Edge length of a voxel
+	UPROPERTY(EditAnywhere, Category = "Occupancy", meta = (ClampMin = "25.0"))
+	float VoxelSize = 100.0f;
+
+	// Distances are stored up to this value (everything further is "free")
+	UPROPERTY(EditAnywhere, Category = "Occupancy", meta = (ClampMin = "100.0"))
+	float MaxDistance = 800.0f;
+
+	// Safety limit for the build (voxel count of the box)
+	UPROPERTY(EditAnywhere, Category = "Occupancy")
+	int32 MaxVoxels = 4000000;
+
+	// Build at BeginPlay in PIE when the level was saved without a grid (slow, logs a warning).
+	// Never in packaged games: without a grid, flying enemies fall back to physics sweeps.
+	UPROPERTY(EditAnywhere, Category = "Occupancy")
+	bool bBuildIfMissing = false;
+
+	// Rasterizes the static geometry in the box and computes the distance field
+	UFUNCTION(CallInEditor, Category = "Occupancy")
+	void BuildGrid();
+
+	bool IsGridBuilt() const { return GetGridData().IsBuilt(); }
+
+	// Is Location covered by the grid?
+	bool ContainsLocation(const FVector& Location) const;
+
+	// See FOccupancyGridData
+	float SampleDistance(const FVector& Location) const { return GetGridData().SampleDistance(Location); }
+	float SampleDistanceAndGradient(const FVector& Location, FVector& OutGradient) const { return GetGridData().SampleDistanceAndGradient(Location, OutGradient); }
+
+	// Is a movable blocking object (door, platform...) within Radius of Location?
+	bool IsNearDynamicObstacle(const FVector& Location, float Radius) const;
+
+	// Voxel size the grid was built with
+	float GetGridVoxelSize() const { return GetGridData().VoxelSize; }
+
+	// The grid, shared with worker threads during play (null before BeginPlay or without a grid)
+	TSharedPtr<const FOccupancyGridData, ESPMode::ThreadSafe> GetSharedGridData() const { return SharedGridData; }
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// Cooked data, saved with the level by BuildGrid
+	UPROPERTY()
+	FOccupancyGridData GridData;
+
+	// Movable blocking actors inside the box at build time
+	UPROPERTY()
+	TArray<AActor*> DynamicObstacles;
+
+private:
+	// GridData moves in here at BeginPlay, so path queries can keep reading it off the game thread
+	TSharedPtr<const FOccupancyGridData, ESPMode::ThreadSafe> SharedGridData;
+
+	const FOccupancyGridData& GetGridData() const { return SharedGridData.IsValid() ? *SharedGridData : GridData; }
+
+	// Blocking primitives of DynamicObstacles, gathered at BeginPlay (their bounds follow them)
+	TArray<TWeakObjectPtr<UPrimitiveComponent>> DynamicPrimitives;
+};
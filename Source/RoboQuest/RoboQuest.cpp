@@ -3,5 +3,13 @@
 #include "RoboQuest.h"
 #include "Modules/ModuleManager.h"
 
+DEFINE_STAT(STAT_LiveProjectiles);
+DEFINE_STAT(STAT_ProjectileRetirements);
+DEFINE_STAT(STAT_SwarmEntities);
+DEFINE_STAT(STAT_SwarmPromotedActors);
+DEFINE_STAT(STAT_EnemyPathRequests);
+DEFINE_STAT(STAT_EnemyPathRequestsPerSecond);
+DEFINE_STAT(STAT_Corpses);
+DEFINE_STAT(STAT_SimulatedRagdolls);
+
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, RoboQuest, "RoboQuest" );
- 
\ No newline at end of file
@@ -3,3 +3,24 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+// Gameplay counters, visible in game with "stat RoboQuest"
+DECLARE_STATS_GROUP(TEXT("RoboQuest"), STATGROUP_RoboQuest, STATCAT_Advanced);
+
+// Projectiles/pellets/simulated bullets currently in flight
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Live Projectiles"), STAT_LiveProjectiles, STATGROUP_RoboQuest, ROBOQUEST_API);
+// Projectiles retired this frame (hit, out of range or expired)
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Projectile Retirements"), STAT_ProjectileRetirements, STATGROUP_RoboQuest, ROBOQUEST_API);
+// Distant enemies simulated as lightweight swarm entities (instanced mesh, no actor)
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Swarm Entities"), STAT_SwarmEntities, STATGROUP_RoboQuest, ROBOQUEST_API);
+// Swarm enemies currently promoted to full actors
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Swarm Promoted Actors"), STAT_SwarmPromotedActors, STATGROUP_RoboQuest, ROBOQUEST_API);
+// Navmesh path requests issued by enemy AI controllers this frame
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Enemy Path Requests"), STAT_EnemyPathRequests, STATGROUP_RoboQuest, ROBOQUEST_API);
+// Same, over the last full second
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Enemy Path Requests/s"), STAT_EnemyPathRequestsPerSecond, STATGROUP_RoboQuest, ROBOQUEST_API);
+// Dead enemies kept in the world (see UCorpseManagerSubsystem)
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Corpses"), STAT_Corpses, STATGROUP_RoboQuest, ROBOQUEST_API);
+// Corpses simulating a ragdoll
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Simulated Ragdolls"), STAT_SimulatedRagdolls, STATGROUP_RoboQuest, ROBOQUEST_API);
@@ -1,14 +1,19 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "RoboQuestProjectile.h"
+#include "RoboQuest.h"
 #include "GameFramework/ProjectileMovementComponent.h"
 #include "Components/SphereComponent.h"
 #include "Components/StatusComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "Enemy/EnemyBase.h" // Include EnemyBase to check for friendly fire
+#include "Subsystems/ProjectilePoolSubsystem.h"
 
 ARoboQuestProjectile::ARoboQuestProjectile()
 {
+	// Tick only to measure the travelled distance (see Tick)
+	PrimaryActorTick.bCanEverTick = true;
+
 	// Use a sphere as a simple collision representation
 	CollisionComp = CreateDefaultSubobject<USphereComponent>(TEXT("SphereComp"));
 	CollisionComp->InitSphereRadius(5.0f);
@@ -29,42 +34,80 @@ ARoboQuestProjectile::ARoboQuestProjectile()
 	ProjectileMovement->MaxSpeed = 3000.f;
 	ProjectileMovement->bRotationFollowsVelocity = true;
 	ProjectileMovement->bShouldBounce = true;
+	ProjectileMovement->OnProjectileStop.AddDynamic(this, &ARoboQuestProjectile::OnProjectileStopped);
 
-	// Die after 3 seconds by default
+	// Die after 3 seconds when no range is given (InitializeProjectile replaces this with a distance budget)
 	InitialLifeSpan = 3.0f;
 }
 
+void ARoboQuestProjectile::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!bIsInFlight || MaxTravelDistance <= 0.0f) return;
+
+	const FVector CurrentLocation = GetActorLocation();
+	TravelledDistance += FVector::Dist(LastLocation, CurrentLocation);
+	LastLocation = CurrentLocation;
+
+	// Out of range: retire exactly where the weapon stats say the shot ends
+	if (TravelledDistance >= MaxTravelDistance)
+	{
+		RetireProjectile();
+	}
+}
+
 void ARoboQuestProjectile::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
 {
+	// Already retired during this move (e.g. multiple hits in one frame)
+	if (!bIsInFlight) return;
+
 	if ((OtherActor != nullptr) && (OtherActor != this) && (OtherActor != GetOwner()))
 	{
-		// Friendly Fire Prevention: Check if both the Shooter and the Victim are Enemies
-		AActor* ProjectileOwner = GetOwner();
-		if (ProjectileOwner)
+		// Friendly fire is filtered out inside; the projectile is retired either way
+		ApplyProjectileDamage(this, GetOwner(), GetInstigatorController(), OtherActor, Damage);
+
+		RetireProjectile();
+	}
+}
+
+void ARoboQuestProjectile::OnProjectileStopped(const FHitResult& ImpactResult)
+{
+	// A projectile at rest would never use up its range
+	if (bIsInFlight && !bIsVisualProxy)
+	{
+		RetireProjectile();
+	}
+}
+
+bool ARoboQuestProjectile::ApplyProjectileDamage(AActor* DamageCauser, AActor* Shooter, AController* InstigatorController, AActor* OtherActor, float DamageAmount)
+{
+	if (!OtherActor) return false;
+
+	// Friendly Fire Prevention: Check if both the Shooter and the Victim are Enemies
+	if (Shooter)
+	{
+		// Try to cast both actors to AEnemyBase (or check class type)
+		bool bIsOwnerEnemy = Shooter->IsA(AEnemyBase::StaticClass());
+		bool bIsHitEnemy = OtherActor->IsA(AEnemyBase::StaticClass());
+
+		// If both are enemies, do not apply damage
+		if (bIsOwnerEnemy && bIsHitEnemy)
 		{
-			// Try to cast both actors to AEnemyBase (or check class type)
-			bool bIsOwnerEnemy = ProjectileOwner->IsA(AEnemyBase::StaticClass());
-			bool bIsHitEnemy = OtherActor->IsA(AEnemyBase::StaticClass());
-
-			// If both are enemies, simply destroy the projectile without applying damage
-			if (bIsOwnerEnemy && bIsHitEnemy)
-			{
-				Destroy();
-				return;
-			}
+			return false;
 		}
+	}
 
-		// Do not directly modify the variables of the other actor (e.g., HP). Use the engine's standard functions instead.
-		UGameplayStatics::ApplyDamage(
-			OtherActor,                     // The actor being hit
-			Damage,                         // Amount of damage
-			GetInstigatorController(),      // Controller of the instigator (used for kill logs, etc.)
-			this,                           // The damage causer (the projectile itself)
-			UDamageType::StaticClass()      // Damage type (change to fire, explosion, etc. if needed)
-		);
+	// Do not directly modify the variables of the other actor (e.g., HP). Use the engine's standard functions instead.
+	UGameplayStatics::ApplyDamage(
+		OtherActor,                                 // The actor being hit
+		DamageAmount,                               // Amount of damage
+		InstigatorController,                       // Controller of the instigator (used for kill logs, etc.)
+		DamageCauser,                               // The damage causer (the projectile itself)
+		UDamageType::StaticClass()                  // Damage type (change to fire, explosion, etc. if needed)
+	);
 
-		Destroy();
-	}
+	return true;
 }
 
 void ARoboQuestProjectile::InitializeProjectile(float NewDamage, float NewRange, float NewCritMul)
@@ -80,8 +123,128 @@ void ARoboQuestProjectile::InitializeProjectile(float NewDamage, float NewRange,
 	}
 
 	// Ignore collision with the owner who fired this projectile to prevent self-damage/instant stop
+	// (cleared first, a pooled projectile may still remember the previous shooter)
+	CollisionComp->ClearMoveIgnoreActors();
 	if (GetOwner())
 	{
 		CollisionComp->IgnoreActorWhenMoving(GetOwner(), true);
 	}
-}
\ No newline at end of file
+
+	if (bIsVisualProxy)
+	{
+		// Range and lifetime are handled by the simulation
+		return;
+	}
+
+	// Range in meters -> distance budget in cm. The lifespan is only kept as a fallback when there is no range.
+	MaxTravelDistance = FMath::Max(0.0f, RangeMeter * 100.0f);
+	TravelledDistance = 0.0f;
+	LastLocation = GetActorLocation();
+	if (MaxTravelDistance > 0.0f)
+	{
+		SetLifeSpan(0.0f);
+	}
+
+	if (!bCountedAsLive)
+	{
+		bCountedAsLive = true;
+		INC_DWORD_STAT(STAT_LiveProjectiles);
+	}
+}
+
+void ARoboQuestProjectile::ActivatePooledProjectile(const FVector& Location, const FRotator& Rotation)
+{
+	bIsInFlight = true;
+	bIsVisualProxy = false;
+	MaxTravelDistance = 0.0f;
+	TravelledDistance = 0.0f;
+	LastLocation = Location;
+
+	SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::ResetPhysics);
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+
+	if (ProjectileMovement)
+	{
+		// The movement component drops its UpdatedComponent when it stops simulating
+		ProjectileMovement->SetUpdatedComponent(CollisionComp);
+		ProjectileMovement->Activate(true);
+	}
+
+	// Restart the default lifespan (LifeSpanExpired returns us to the pool)
+	SetLifeSpan(InitialLifeSpan);
+	SetActorTickEnabled(true);
+}
+
+void ARoboQuestProjectile::DeactivatePooledProjectile()
+{
+	bIsInFlight = false;
+
+	// Clear the lifespan timer
+	SetLifeSpan(0.0f);
+	SetActorTickEnabled(false);
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+
+	if (ProjectileMovement)
+	{
+		ProjectileMovement->StopMovementImmediately();
+		ProjectileMovement->Deactivate();
+	}
+
+	CollisionComp->ClearMoveIgnoreActors();
+}
+
+void ARoboQuestProjectile::ActivateAsVisualProxy(const FVector& Location, const FRotator& Rotation)
+{
+	ActivatePooledProjectile(Location, Rotation);
+	bIsVisualProxy = true;
+
+	// The simulation owns movement, hits, range and lifetime
+	SetLifeSpan(0.0f);
+	SetActorTickEnabled(false);
+	SetActorEnableCollision(false);
+
+	if (ProjectileMovement)
+	{
+		ProjectileMovement->Deactivate();
+	}
+}
+
+void ARoboQuestProjectile::RetireProjectile()
+{
+	if (bCountedAsLive)
+	{
+		bCountedAsLive = false;
+		DEC_DWORD_STAT(STAT_LiveProjectiles);
+		INC_DWORD_STAT(STAT_ProjectileRetirements);
+	}
+
+	if (bIsPooled)
+	{
+		if (UProjectilePoolSubsystem* Pool = GetWorld()->GetSubsystem<UProjectilePoolSubsystem>())
+		{
+			Pool->ReleaseProjectile(this);
+			return;
+		}
+	}
+
+	Destroy();
+}
+
+void ARoboQuestProjectile::LifeSpanExpired()
+{
+	RetireProjectile();
+}
+
+void ARoboQuestProjectile::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (bCountedAsLive)
+	{
+		bCountedAsLive = false;
+		DEC_DWORD_STAT(STAT_LiveProjectiles);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
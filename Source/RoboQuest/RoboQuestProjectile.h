@@ -23,20 +23,73 @@ class ARoboQuestProjectile : public AActor
 	UProjectileMovementComponent* ProjectileMovement;
 
 public:
+	/** If true, shots of this class are simulated by UBallisticSimulationSubsystem instead of ticking their own actor */
+	UPROPERTY(EditDefaultsOnly, Category=Projectile)
+	bool bSimulateCentrally = false;
+
+	/** For centrally simulated shots: show a pooled actor of this class following the bullet (no collision, no movement tick) */
+	UPROPERTY(EditDefaultsOnly, Category=Projectile, meta = (EditCondition = "bSimulateCentrally"))
+	bool bSpawnVisualProxy = true;
+
 	ARoboQuestProjectile();
 
+	/** Tracks the travelled distance against the range budget */
+	virtual void Tick(float DeltaTime) override;
+
 	/** called when projectile hits something */
 	UFUNCTION()
 	void OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
 
+	/** called when the movement component comes to rest (e.g. after bouncing out its velocity) */
+	UFUNCTION()
+	void OnProjectileStopped(const FHitResult& ImpactResult);
+
 	/** Returns CollisionComp subobject **/
 	USphereComponent* GetCollisionComp() const { return CollisionComp; }
 	/** Returns ProjectileMovement subobject **/
 	UProjectileMovementComponent* GetProjectileMovement() const { return ProjectileMovement; }
 
-	// Projectile properties
+	// Projectile properties. NewRange (meters) is the distance budget: the projectile retires once it has
+	// travelled that far. With no range (<= 0) it falls back to InitialLifeSpan.
 	void InitializeProjectile(float NewDamage, float NewRange, float NewCritMul);
 
+	// Shared damage path for everything that shoots (projectiles, pellet batches, simulated bullets...).
+	// Applies DamageAmount to OtherActor unless Shooter and OtherActor are both enemies. Returns true if damage was applied.
+	static bool ApplyProjectileDamage(AActor* DamageCauser, AActor* Shooter, AController* InstigatorController, AActor* OtherActor, float DamageAmount);
+
+	// --- Pooling (see UProjectilePoolSubsystem) ---
+
+	// Called by the pool right after spawning this projectile
+	void MarkAsPooled() { bIsPooled = true; }
+
+	// Was this projectile created by the projectile pool?
+	bool IsPooled() const { return bIsPooled; }
+
+	// Is this projectile currently flying (false while parked in the pool)
+	bool IsInFlight() const { return bIsInFlight; }
+
+	// Moves the projectile to the given transform and re-enables movement, collision and visibility
+	void ActivatePooledProjectile(const FVector& Location, const FRotator& Rotation);
+
+	// Hides the projectile and stops movement/collision until it is acquired again
+	void DeactivatePooledProjectile();
+
+	// Shows the projectile as a pure visual: no collision, no movement component, no lifespan.
+	// Its owner (UBallisticSimulationSubsystem) moves and retires it.
+	void ActivateAsVisualProxy(const FVector& Location, const FRotator& Rotation);
+
+	// Ends this shot: returns the projectile to its pool, or destroys it if it is not pooled
+	void RetireProjectile();
+
+protected:
+	// Return to the pool instead of being destroyed when the lifespan runs out
+	virtual void LifeSpanExpired() override;
+
+	// Keeps the live projectile stat balanced when the world tears down shots in flight
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+public:
+
 	// Damage dealt by this projectile
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Projectile")
 	float Damage;
@@ -46,5 +99,25 @@ public:
 	// Critical damage multiplier
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Projectile")
 	float CritDamageMultiplier;
+
+private:
+	// Created by UProjectilePoolSubsystem
+	bool bIsPooled = false;
+
+	// False while the projectile is parked in the pool
+	bool bIsInFlight = true;
+
+	// True while following a centrally simulated bullet
+	bool bIsVisualProxy = false;
+
+	// True while this shot is counted in STAT_LiveProjectiles
+	bool bCountedAsLive = false;
+
+	// Distance budget in cm (0 = unlimited) and distance travelled so far
+	float MaxTravelDistance = 0.0f;
+	float TravelledDistance = 0.0f;
+
+	// Location at the previous tick, to accumulate TravelledDistance
+	FVector LastLocation = FVector::ZeroVector;
 };
 
@@ -4,6 +4,9 @@
 #include "TP_WeaponComponent.h"
 #include "RoboQuestCharacter.h"
 #include "RoboQuestProjectile.h"
+#include "Projectiles/RoboQuestPelletBatch.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
 #include "GameFramework/PlayerController.h"
 #include "Camera/PlayerCameraManager.h"
 #include "Kismet/GameplayStatics.h"
@@ -13,6 +16,9 @@
 #include "Engine/LocalPlayer.h"
 #include "Engine/World.h"
 #include "TimerManager.h" 
+#include "Subsystems/ProjectilePoolSubsystem.h"
+#include "Subsystems/BallisticSimulationSubsystem.h"
+#include "Subsystems/EnemyPerceptionSubsystem.h"
 
 // Sets default values for this component's properties
 UTP_WeaponComponent::UTP_WeaponComponent()
@@ -51,6 +57,8 @@ void UTP_WeaponComponent::InitializeWeapon(FName NewWeaponRowName)
 		RangeMeter = Row->RangeMeter;
 		ReloadTime = Row->ReloadTime;
 		CritDamageMultiplier = Row->CritDamage;
+		SpreadAngle = Row->SpreadAngle;
+		bHitscan = Row->bHitscan;
 		
 		// Apply Enums
 		AmmoType = Row->AmmoType;
@@ -65,6 +73,32 @@ void UTP_WeaponComponent::InitializeWeapon(FName NewWeaponRowName)
 		{
 			OnAmmoChanged.Broadcast(CurrentAmmo, MaxAmmo);
 		}
+
+		// Pre-warm the pool with what this weapon actually fires and can have in flight at once (hitscan fires nothing)
+		UProjectilePoolSubsystem* Pool = bHitscan ? nullptr : GetWorld()->GetSubsystem<UProjectilePoolSubsystem>();
+		if (Pool && BulletCount > 1 && PelletBatchClass != nullptr)
+		{
+			// One batch per shot, alive until its pellets have used up their range
+			const ARoboQuestPelletBatch* Defaults = PelletBatchClass.GetDefaultObject();
+			const float LifeSpan = (RangeMeter > 0.0f && Defaults->PelletSpeed > 0.0f)
+				? RangeMeter * 100.0f / Defaults->PelletSpeed
+				: Defaults->InitialLifeSpan;
+			Pool->PrewarmPelletBatches(PelletBatchClass, FMath::Max(1, FMath::CeilToInt(RateOfFire * LifeSpan)));
+		}
+		else if (Pool && ProjectileClass != nullptr)
+		{
+			// Centrally simulated shots only take actors from the pool for their visual proxy
+			const ARoboQuestProjectile* Defaults = ProjectileClass.GetDefaultObject();
+			if (!Defaults->bSimulateCentrally || Defaults->bSpawnVisualProxy)
+			{
+				// A shot lives until it has used up its range (or its default lifespan when there is no range)
+				const UProjectileMovementComponent* DefaultMovement = Defaults->GetProjectileMovement();
+				const float LifeSpan = (RangeMeter > 0.0f && DefaultMovement && DefaultMovement->InitialSpeed > 0.0f)
+					? RangeMeter * 100.0f / DefaultMovement->InitialSpeed
+					: Defaults->InitialLifeSpan;
+				Pool->PrewarmPool(ProjectileClass, FMath::Max(1, FMath::CeilToInt(RateOfFire * LifeSpan)) * BulletCount);
+			}
+		}
 	}
 }
 
@@ -109,29 +143,49 @@ void UTP_WeaponComponent::Fire()
 	}
 
 	// Spawn Projectile(s)
-	if (ProjectileClass != nullptr)
+	UWorld* const World = GetWorld();
+	if (World != nullptr && (bHitscan || ProjectileClass != nullptr || PelletBatchClass != nullptr))
 	{
-		UWorld* const World = GetWorld();
-		if (World != nullptr)
+		APlayerController* PlayerController = Cast<APlayerController>(Character->GetController());
+
+		// Aim once per shot, every bullet of the shot shares the camera rotation
+		const FRotator AimRotation = PlayerController->PlayerCameraManager->GetCameraRotation();
+		const FVector SpawnLocation = GetOwner()->GetActorLocation() + AimRotation.RotateVector(MuzzleOffset);
+
+		if (bHitscan)
+		{
+			// Hitscan row: no projectile at all, every bullet is a line trace
+			FireHitscan(SpawnLocation, AimRotation);
+		}
+		else if (BulletCount > 1 && PelletBatchClass != nullptr)
 		{
-			APlayerController* PlayerController = Cast<APlayerController>(Character->GetController());
-			
-			for(int32 i = 0; i < BulletCount; i++)
+			// Multi-bullet shot: simulate all pellets inside a single actor
+			TArray<FVector> PelletDirections;
+			PelletDirections.Reserve(BulletCount);
+			for (int32 i = 0; i < BulletCount; i++)
 			{
-				FRotator SpawnRotation = PlayerController->PlayerCameraManager->GetCameraRotation();
-				const FVector SpawnLocation = GetOwner()->GetActorLocation() + SpawnRotation.RotateVector(MuzzleOffset);
-		
-				FActorSpawnParameters ActorSpawnParams;
-				// Adjust collision handling to always spawn even if colliding with something
-				ActorSpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-		
-                // Spawn
-				ARoboQuestProjectile* Projectile = World->SpawnActor<ARoboQuestProjectile>(ProjectileClass, SpawnLocation, SpawnRotation, ActorSpawnParams);
-				
-				if (Projectile)
-				{
-					Projectile->InitializeProjectile(Damage, RangeMeter, CritDamageMultiplier);
-				}
+				PelletDirections.Add(GetSpreadDirection(AimRotation));
+			}
+
+			// Taken from the projectile pool, like single bullets
+			UProjectilePoolSubsystem* Pool = World->GetSubsystem<UProjectilePoolSubsystem>();
+			ARoboQuestPelletBatch* PelletBatch = Pool ? Pool->AcquirePelletBatch(PelletBatchClass, SpawnLocation, AimRotation, Character, Character) : nullptr;
+			if (PelletBatch)
+			{
+				PelletBatch->InitializePellets(SpawnLocation, PelletDirections, Damage, RangeMeter, CritDamageMultiplier);
+			}
+		}
+		else if (ProjectileClass != nullptr)
+		{
+			UBallisticSimulationSubsystem* Ballistics = World->GetSubsystem<UBallisticSimulationSubsystem>();
+
+			for(int32 i = 0; Ballistics != nullptr && i < BulletCount; i++)
+			{
+				const FRotator SpawnRotation = (SpreadAngle > 0.0f) ? GetSpreadDirection(AimRotation).Rotation() : AimRotation;
+
+                // Simulated centrally or taken from the projectile pool (always placed, even if colliding with something).
+				// Fired by the character, so the shot ignores it and enemies know who hit them.
+				Ballistics->FireProjectile(ProjectileClass, SpawnLocation, SpawnRotation, Character, Character, Damage, RangeMeter, CritDamageMultiplier);
 			}
 		}
 	}
@@ -141,6 +195,12 @@ void UTP_WeaponComponent::Fire()
 	if (FireSound != nullptr)
 	{
 		UGameplayStatics::PlaySoundAtLocation(this, FireSound, Character->GetActorLocation());
+
+		// Enemies within hearing range notice the shot
+		if (UEnemyPerceptionSubsystem* Perception = GetWorld()->GetSubsystem<UEnemyPerceptionSubsystem>())
+		{
+			Perception->ReportNoise(Character, Character->GetActorLocation());
+		}
 	}
 	
 	// Try and play a firing animation if specified
@@ -233,6 +293,80 @@ void UTP_WeaponComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 	}
 }
 
+FVector UTP_WeaponComponent::GetSpreadDirection(const FRotator& AimRotation) const
+{
+	if (SpreadAngle <= 0.0f)
+	{
+		return AimRotation.Vector();
+	}
+
+	return FMath::VRandCone(AimRotation.Vector(), FMath::DegreesToRadians(SpreadAngle));
+}
+
+void UTP_WeaponComponent::FireHitscan(const FVector& Start, const FRotator& AimRotation)
+{
+	UWorld* const World = GetWorld();
+	if (World == nullptr) return;
+
+	// Range in meters -> cm; rows without a range fall back to a fixed distance, like projectiles fall back to their lifespan
+	const float TraceLength = (RangeMeter > 0.0f) ? RangeMeter * 100.0f : HitscanFallbackRange;
+	AController* InstigatorController = Character->GetController();
+
+	// Shared query params for every bullet of the shot: never hit ourselves
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(WeaponHitscan), false, GetOwner());
+	Params.AddIgnoredActor(Character);
+
+	// Where every bullet of the shot stopped, for the tracers
+	TArray<FTransform> TracerTransforms;
+	TracerTransforms.Reserve(BulletCount);
+
+	for (int32 i = 0; i < BulletCount; i++)
+	{
+		const FVector End = Start + GetSpreadDirection(AimRotation) * TraceLength;
+
+		FHitResult Hit;
+		const bool bHit = World->LineTraceSingleByProfile(Hit, Start, End, HitscanProfileName, Params);
+
+		// Same damage path (and friendly fire rules) as projectiles
+		if (bHit)
+		{
+			ARoboQuestProjectile::ApplyProjectileDamage(GetOwner(), Character, InstigatorController, Hit.GetActor(), Damage);
+		}
+
+		// Cosmetic only: a tracer from the muzzle to where the bullet stopped
+		const FVector TracerEnd = bHit ? Hit.ImpactPoint : End;
+		TracerTransforms.Emplace((TracerEnd - Start).Rotation(), Start, FVector((TracerEnd - Start).Size() / 100.0f, TracerThickness, TracerThickness));
+	}
+
+	if (TracerMesh == nullptr) return;
+
+	// One instanced component draws every tracer of the shot
+	if (TracerInstances == nullptr)
+	{
+		TracerInstances = NewObject<UInstancedStaticMeshComponent>(GetOwner(), TEXT("TracerInstances"));
+		TracerInstances->SetUsingAbsoluteLocation(true);
+		TracerInstances->SetUsingAbsoluteRotation(true);
+		TracerInstances->SetUsingAbsoluteScale(true);
+		TracerInstances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		TracerInstances->SetCastShadow(false);
+		TracerInstances->SetStaticMesh(TracerMesh);
+		TracerInstances->RegisterComponent();
+	}
+
+	TracerInstances->ClearInstances();
+	TracerInstances->AddInstances(TracerTransforms, false, true);
+
+	World->GetTimerManager().SetTimer(TracerClearTimer, this, &UTP_WeaponComponent::ClearTracers, TracerDuration, false);
+}
+
+void UTP_WeaponComponent::ClearTracers()
+{
+	if (TracerInstances != nullptr)
+	{
+		TracerInstances->ClearInstances();
+	}
+}
+
 bool UTP_WeaponComponent::CanFire() const
 {
 	// Can fire if character is valid, has ammo, and is not reloading
@@ -22,6 +22,30 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category=Projectile)
 	TSubclassOf<class ARoboQuestProjectile> ProjectileClass;
 
+	/** Pellet batch class used instead of individual projectiles when BulletCount > 1 */
+	UPROPERTY(EditDefaultsOnly, Category=Projectile)
+	TSubclassOf<class ARoboQuestPelletBatch> PelletBatchClass;
+
+	/** Cosmetic tracer mesh (100 cm long along X), drawn as one instance per hitscan bullet on a single instanced component */
+	UPROPERTY(EditDefaultsOnly, Category=Hitscan)
+	class UStaticMesh* TracerMesh;
+
+	/** Thickness scale (Y/Z) of the tracer instances */
+	UPROPERTY(EditDefaultsOnly, Category=Hitscan)
+	float TracerThickness = 0.05f;
+
+	/** How long the tracers of one shot stay visible, in seconds */
+	UPROPERTY(EditDefaultsOnly, Category=Hitscan)
+	float TracerDuration = 0.05f;
+
+	/** Collision profile used by hitscan traces (same as projectiles so both hit the same things) */
+	UPROPERTY(EditDefaultsOnly, Category=Hitscan)
+	FName HitscanProfileName = TEXT("Projectile");
+
+	/** Trace length in cm for rows without a range (RangeMeter <= 0): how far a default projectile flies in its 3 s lifespan */
+	UPROPERTY(EditDefaultsOnly, Category=Hitscan)
+	float HitscanFallbackRange = 9000.0f;
+
 	/** Sound to play each time we fire */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Gameplay)
 	USoundBase* FireSound;
@@ -91,6 +115,14 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Stats")
 	float CritDamageMultiplier = 1.5f;
 
+	// Spread cone half-angle in degrees
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Stats")
+	float SpreadAngle = 0.0f;
+
+	// Shots are resolved with line traces instead of projectiles
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Stats")
+	bool bHitscan = false;
+
 	// Enum Stats
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Stats")
 	EAmmoType AmmoType;
@@ -152,12 +184,27 @@ protected:
     /** Helper to stop the timer without clearing input state (Internal use) */
     void StopAutomaticFire();
 
+	/** Returns the direction of one bullet, randomized inside the SpreadAngle cone */
+	FVector GetSpreadDirection(const FRotator& AimRotation) const;
+
+	/** Resolves every bullet of one shot with line traces in a single pass (no actor spawned) */
+	void FireHitscan(const FVector& Start, const FRotator& AimRotation);
+
+	/** Hides the tracers of the last hitscan shot */
+	void ClearTracers();
+
 private:
 	/** The Character holding this weapon*/
 	ARoboQuestCharacter* Character;
 
 	/** Last time the weapon was fired (for RateOfFire calculation) */
 	double LastFireTime = 0.0;
+
+	/** Instanced tracers of the last hitscan shot, reused by every shot (created on first use) */
+	UPROPERTY()
+	class UInstancedStaticMeshComponent* TracerInstances;
+
+	FTimerHandle TracerClearTimer;
     
     /** Is the fire input button currently held? */
     bool bFireInputHeld = false;